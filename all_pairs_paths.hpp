@@ -0,0 +1,382 @@
+#ifndef ALL_PAIRS_PATHS_H
+#define ALL_PAIRS_PATHS_H
+
+#include <string>
+#include <fstream>
+#include "undirected_graph.hpp"
+
+namespace graph
+{
+    // Shortest distances and paths between all pairs of vertices of a snapshot of a graph, kept as two dense V x V matrices:
+    // the distances, and the next vertex on every shortest path. A path is only spelled out when it is asked for,
+    // so the table costs O(V^2) memory instead of O(V^2 * path length). It does not follow later changes to the graph.
+    template<typename T, typename W>
+    class undirected_graph<T, W>::all_pairs_paths
+    {
+        friend class undirected_graph<T, W>;
+
+        private:
+            std::vector<T> _row_to_node_;                       // (row - vertex) mapping.
+            std::unordered_map<T, std::uint32_t> _node_to_row_; // (vertex - row) mapping.
+            dense_matrix<double> _distance_;                    // (source row, destination row) - shortest distance.
+            dense_matrix<std::uint32_t> _next_;                 // (source row, destination row) - row of the vertex after the source on the path, npos() if none.
+
+            static std::uint32_t npos()
+            {
+                return std::numeric_limits<std::uint32_t>::max();
+            }
+
+            // Given the graph, runs the all pairs search.
+            explicit all_pairs_paths(const undirected_graph<T, W> &);
+
+            // Labels are stored as raw bytes(arithmetic types) or as length + characters(std::string).
+            // Reading a label fails the stream rather than read past the given number of bytes left in the file.
+            template<typename L>
+            static typename std::enable_if<std::is_arithmetic<L>::value>::type writeLabel(std::ostream &, const L &);
+            static void writeLabel(std::ostream &, const std::string &);
+            template<typename L>
+            static typename std::enable_if<std::is_arithmetic<L>::value>::type readLabel(std::istream &, L &, std::uint64_t);
+            static void readLabel(std::istream &, std::string &, std::uint64_t);
+
+            // Returns true if, for every pair, following the next vertices from the source reaches the destination, in O(V^2).
+            bool validPaths() const;
+
+        public:
+            // Walks a path one vertex at a time, following the next vertex matrix.
+            class path_iterator
+            {
+                friend class all_pairs_paths;
+
+                private:
+                    const all_pairs_paths *_table_{nullptr};
+                    std::uint32_t _at_{npos()};                 // Row of the current vertex, npos() past the end.
+                    std::uint32_t _end_{npos()};                // Row of the destination.
+
+                    path_iterator(const all_pairs_paths *table, std::uint32_t at, std::uint32_t end) : _table_ (table), _at_ (at), _end_ (end)
+                    {
+                    }
+
+                public:
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef T value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef const T* pointer;
+                    typedef const T& reference;
+
+                    path_iterator() = default;
+
+                    bool operator==(const path_iterator &rhs) const
+                    {
+                        return _at_ == rhs._at_;
+                    }
+                    bool operator!=(const path_iterator &rhs) const
+                    {
+                        return _at_ != rhs._at_;
+                    }
+                    path_iterator& operator++()
+                    {
+                        _at_ = _at_ == _end_ ? npos() : _table_->_next_[_at_][_end_];
+                        return *this;
+                    }
+                    path_iterator operator++(int)
+                    {
+                        path_iterator old = *this;
+                        ++*this;
+                        return old;
+                    }
+                    const T& operator*() const
+                    {
+                        return _table_->_row_to_node_[_at_];
+                    }
+                    const T* operator->() const
+                    {
+                        return &_table_->_row_to_node_[_at_];
+                    }
+            };
+
+            // The vertices of one path, from the source to the destination, for use in range-based for loops.
+            class path_range
+            {
+                public:
+                    path_iterator first;
+                    path_iterator last;
+
+                    path_iterator begin() const
+                    {
+                        return first;
+                    }
+                    path_iterator end() const
+                    {
+                        return last;
+                    }
+                    bool empty() const
+                    {
+                        return first == last;
+                    }
+            };
+
+            // Default constructor(an empty table).
+            all_pairs_paths();
+
+            /*
+             *  If the destination is not reachable, distance is inf. If the destination is a part of negative cycle, distance is -inf.
+             *  If any of the vertex is invalid, distance is -1.
+             *  If the destination is not reachable || is a part of negative cycle || If any of the vertex is invalid, path is EMPTY.
+             */
+            // Given two vertices, returns the length of shortest path between them, in O(1).
+            double shortestDistance(T, T) const;
+            // Given two vertices, returns the shortest path between them.
+            std::vector<T> shortestPath(T, T) const;
+            // Given two vertices, returns the shortest path between them as a range that is walked lazily.
+            path_range pathRange(T, T) const;
+
+            // Returns the vertices of the table.
+            const std::vector<T>& vertices() const;
+            // Returns the number of vertices of the table.
+            std::size_t size() const;
+            // Returns true if the table has no vertices.
+            bool empty() const;
+
+            // Writes the table to the given file. Vertex labels must be arithmetic types or std::string. Returns false on failure.
+            bool save(const std::string &) const;
+            // Replaces the table with one written by save. Returns false(and keeps the table) if the file cannot be read.
+            bool load(const std::string &);
+    };
+
+    template<typename T, typename W>
+    typename undirected_graph<T, W>::all_pairs_paths undirected_graph<T, W>::allPairsShortestPaths() const
+    {
+        return all_pairs_paths(*this);
+    }
+
+    template<typename T, typename W>
+    undirected_graph<T, W>::all_pairs_paths::all_pairs_paths()
+    {
+    }
+
+    template<typename T, typename W>
+    undirected_graph<T, W>::all_pairs_paths::all_pairs_paths(const undirected_graph<T, W> &G)
+    {
+        std::vector<unsigned int> Ids;
+        for(unsigned int id = 1; id < G._id_; ++id)
+            if(G.isVertex(id))
+            {
+                Ids.push_back(id);
+                _node_to_row_[G._id_to_node_[id]] = _row_to_node_.size();
+                _row_to_node_.push_back(G._id_to_node_[id]);
+            }
+
+        G.allPairsSearch(Ids, _distance_, _next_);
+    }
+
+    template<typename T, typename W>
+    double undirected_graph<T, W>::all_pairs_paths::shortestDistance(T start, T end) const
+    {
+        // If any of the vertex is invalid, return -1.
+        typename std::unordered_map<T, std::uint32_t>::const_iterator s = _node_to_row_.find(start);
+        typename std::unordered_map<T, std::uint32_t>::const_iterator e = _node_to_row_.find(end);
+        if(s == _node_to_row_.end() || e == _node_to_row_.end())
+            return -1;
+
+        return _distance_[s->second][e->second];
+    }
+
+    template<typename T, typename W>
+    std::vector<T> undirected_graph<T, W>::all_pairs_paths::shortestPath(T start, T end) const
+    {
+        path_range Range = pathRange(start, end);
+        return std::vector<T>(Range.begin(), Range.end());
+    }
+
+    template<typename T, typename W>
+    typename undirected_graph<T, W>::all_pairs_paths::path_range undirected_graph<T, W>::all_pairs_paths::pathRange(T start, T end) const
+    {
+        path_range Range;
+
+        // If any of the vertex is invalid, return empty range.
+        typename std::unordered_map<T, std::uint32_t>::const_iterator s = _node_to_row_.find(start);
+        typename std::unordered_map<T, std::uint32_t>::const_iterator e = _node_to_row_.find(end);
+        if(s == _node_to_row_.end() || e == _node_to_row_.end())
+            return Range;
+
+        // If the vertex is unreachable || is a part of negative weight cycle, return empty range.
+        double dist = _distance_[s->second][e->second];
+        if(dist == std::numeric_limits<double>::infinity() || dist == std::numeric_limits<double>::infinity() * -1)
+            return Range;
+
+        Range.first = path_iterator(this, s->second, e->second);
+        Range.last = path_iterator(this, npos(), e->second);
+        return Range;
+    }
+
+    template<typename T, typename W>
+    const std::vector<T>& undirected_graph<T, W>::all_pairs_paths::vertices() const
+    {
+        return _row_to_node_;
+    }
+
+    template<typename T, typename W>
+    std::size_t undirected_graph<T, W>::all_pairs_paths::size() const
+    {
+        return _row_to_node_.size();
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::all_pairs_paths::empty() const
+    {
+        return _row_to_node_.empty();
+    }
+
+    template<typename T, typename W>
+    template<typename L>
+    typename std::enable_if<std::is_arithmetic<L>::value>::type undirected_graph<T, W>::all_pairs_paths::writeLabel(std::ostream &Out, const L &label)
+    {
+        Out.write(reinterpret_cast<const char*>(&label), sizeof(L));
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::all_pairs_paths::writeLabel(std::ostream &Out, const std::string &label)
+    {
+        std::uint64_t length = label.size();
+        Out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        Out.write(label.data(), length);
+    }
+
+    template<typename T, typename W>
+    template<typename L>
+    typename std::enable_if<std::is_arithmetic<L>::value>::type undirected_graph<T, W>::all_pairs_paths::readLabel(std::istream &In, L &label, std::uint64_t)
+    {
+        In.read(reinterpret_cast<char*>(&label), sizeof(L));
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::all_pairs_paths::readLabel(std::istream &In, std::string &label, std::uint64_t left)
+    {
+        std::uint64_t length = 0;
+        In.read(reinterpret_cast<char*>(&length), sizeof(length));
+        if(!In)
+            return;
+        if(length > left - sizeof(length))
+        {
+            In.setstate(std::ios::failbit);
+            return;
+        }
+        label.resize(length);
+        In.read(&label[0], length);
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::all_pairs_paths::validPaths() const
+    {
+        // For each destination, the next vertices must form a tree rooted at it(plus the vertices without a path). Each vertex is walked
+        // at most once per destination: a walk stops at the first vertex already known to reach it.
+        enum : unsigned char { Unknown, OnWalk, Reaches, NoPath };
+        std::size_t V = _row_to_node_.size();
+        std::vector<unsigned char> State(V);
+        std::vector<std::uint32_t> Walk;
+        for(std::uint32_t j = 0; j < V; ++j)
+        {
+            std::fill(State.begin(), State.end(), Unknown);
+            State[j] = Reaches;
+            for(std::uint32_t i = 0; i < V; ++i)
+            {
+                if(State[i] != Unknown)
+                    continue;
+                if(_next_[i][j] == npos())
+                {
+                    State[i] = NoPath;
+                    continue;
+                }
+
+                std::uint32_t at = i;
+                Walk.clear();
+                while(State[at] == Unknown)
+                {
+                    std::uint32_t next = _next_[at][j];
+                    if(next >= V)
+                        return false;
+                    State[at] = OnWalk;
+                    Walk.push_back(at);
+                    at = next;
+                }
+
+                // A cycle, or a path that stops short of the destination.
+                if(State[at] != Reaches)
+                    return false;
+                for(std::uint32_t on : Walk)
+                    State[on] = Reaches;
+            }
+        }
+
+        return true;
+    }
+
+    // File layout: "APSP", number of vertices(64 bits), the labels in row order, then the distance and next vertex matrices row by row(without padding).
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::all_pairs_paths::save(const std::string &filename) const
+    {
+        std::ofstream Out(filename, std::ios::binary);
+        if(!Out)
+            return false;
+
+        std::uint64_t V = _row_to_node_.size();
+        Out.write("APSP", 4);
+        Out.write(reinterpret_cast<const char*>(&V), sizeof(V));
+        for(const T &label : _row_to_node_)
+            writeLabel(Out, label);
+        for(std::size_t i = 0; i < V; ++i)
+            Out.write(reinterpret_cast<const char*>(_distance_[i]), V * sizeof(double));
+        for(std::size_t i = 0; i < V; ++i)
+            Out.write(reinterpret_cast<const char*>(_next_[i]), V * sizeof(std::uint32_t));
+
+        return static_cast<bool>(Out);
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::all_pairs_paths::load(const std::string &filename)
+    {
+        std::ifstream In(filename, std::ios::binary | std::ios::ate);
+        std::streamoff size = In.tellg();
+        char magic[4];
+        std::uint64_t V = 0;
+        if(!In || size < 12 || !In.seekg(0) || !In.read(magic, 4) || std::string(magic, 4) != "APSP" || !In.read(reinterpret_cast<char*>(&V), sizeof(V)))
+            return false;
+
+        // Nothing is allocated for the vertices before the file is known to be long enough to hold them: every row takes at least
+        // one byte of label and 12 * V bytes of matrices.
+        std::uint64_t left = size - 12;
+        std::uint64_t matrices = sizeof(double) + sizeof(std::uint32_t);
+        if(V >= npos() || (V > 0 && V > left / (matrices * V + 1)))
+            return false;
+
+        // Read into a new table, so a truncated file leaves this one untouched.
+        all_pairs_paths Table;
+        for(std::uint64_t i = 0; i < V && In; ++i)
+        {
+            T label;
+            readLabel(In, label, size - std::streamoff(In.tellg()));
+            Table._node_to_row_[label] = i;
+            Table._row_to_node_.push_back(label);
+        }
+        if(!In || Table._node_to_row_.size() != V || size - std::streamoff(In.tellg()) != std::streamoff(matrices * V * V))
+            return false;
+
+        Table._distance_ = dense_matrix<double>(V, std::numeric_limits<double>::infinity());
+        Table._next_ = dense_matrix<std::uint32_t>(V, npos());
+        for(std::size_t i = 0; i < V; ++i)
+            In.read(reinterpret_cast<char*>(Table._distance_[i]), V * sizeof(double));
+        for(std::size_t i = 0; i < V; ++i)
+            In.read(reinterpret_cast<char*>(Table._next_[i]), V * sizeof(std::uint32_t));
+        if(!In)
+            return false;
+
+        // A next vertex outside the table would make paths walk out of it, and a cycle of next vertices would make them endless.
+        if(!Table.validPaths())
+            return false;
+
+        *this = std::move(Table);
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef BFS_FRONTIER_H
+#define BFS_FRONTIER_H
+
+#include <atomic>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+namespace graph
+{
+    // Returns the position of the lowest set bit of a non-zero word, for walking the set bits of a bitmap word.
+    inline unsigned int lowestBit(std::uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+    #else
+        unsigned int position = 0;
+        for(; !(x & 1); x >>= 1)
+            ++position;
+        return position;
+    #endif
+    }
+
+    // One bit per vertex id, packed 64 to a word. The words are atomic so that several threads can mark ids at once(claim);
+    // set is the cheaper form for a word that no other thread writes at the same time.
+    class vertex_bitmap
+    {
+        private:
+            std::vector<std::atomic<std::uint64_t>> _words_;
+
+        public:
+            // Makes room for ids in [0, n) and clears every bit.
+            void reset(std::size_t n)
+            {
+                _words_ = std::vector<std::atomic<std::uint64_t>>((n + 63) / 64);
+            }
+
+            bool test(std::size_t id) const
+            {
+                return (_words_[id >> 6].load(std::memory_order_relaxed) >> (id & 63)) & 1;
+            }
+
+            void set(std::size_t id)
+            {
+                std::atomic<std::uint64_t> &word = _words_[id >> 6];
+                word.store(word.load(std::memory_order_relaxed) | std::uint64_t(1) << (id & 63), std::memory_order_relaxed);
+            }
+
+            // Sets the bit atomically. Returns true if this call set it(i.e. no other thread got there first).
+            bool claim(std::size_t id)
+            {
+                std::uint64_t bit = std::uint64_t(1) << (id & 63);
+                return !(_words_[id >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+            }
+
+            std::size_t words() const
+            {
+                return _words_.size();
+            }
+
+            std::uint64_t word(std::size_t i) const
+            {
+                return _words_[i].load(std::memory_order_relaxed);
+            }
+    };
+
+    // State a direction-optimizing BFS carries from one level to the next, and from one search to the next when several searches
+    // share the visited set(e.g. one search per connected component).
+    // Each level is expanded either top-down(the frontier scans its out-edges) or bottom-up(every unvisited vertex scans its in-edges
+    // until it finds a parent in the frontier). Bottom-up pays off once the frontier holds a large share of the remaining edges, as in
+    // the middle levels of a low diameter graph, because most unvisited vertices find a parent after inspecting a few edges.
+    class bfs_frontier
+    {
+        public:
+            vertex_bitmap Visited;                      // Ids reached so far(plus id 0 and the padding past the last id, so they are never scanned).
+            vertex_bitmap Current;                      // Ids of the level being expanded, filled only for bottom-up steps.
+            std::size_t Unexplored{unknown()};          // Number of in-edges of the unvisited vertices, unknown() until a bottom-up step is considered.
+            bool BottomUp{false};                       // Direction of the last step.
+            std::size_t LastSize{0};                    // Number of vertices in the last frontier.
+
+            // Beamer's thresholds: go bottom-up once the frontier's out-edges exceed Unexplored / Alpha, and back top-down once the
+            // frontier shrinks below ids / Beta.
+            static constexpr std::size_t Alpha = 14;
+            static constexpr std::size_t Beta = 24;
+
+            static std::size_t unknown()
+            {
+                return std::numeric_limits<std::size_t>::max();
+            }
+
+            // Prepares the state for searches over ids in [0, n).
+            void reset(std::size_t n)
+            {
+                Visited.reset(n);
+                Visited.set(0);
+                for(std::size_t id = n; id < Visited.words() * 64; ++id)
+                    Visited.set(id);
+                Unexplored = unknown();
+                BottomUp = false;
+                LastSize = 0;
+            }
+
+            // Picks the direction of the next step, given the size of the frontier, its out-edges and the number of ids.
+            // A bottom-up step scans every id, so it is only considered for a frontier with that many edges; count() returns
+            // the in-edges of the unvisited vertices and is only called the first time Unexplored is needed.
+            template<typename Count>
+            void choose(std::size_t frontierSize, std::size_t frontierEdges, std::size_t ids, Count count)
+            {
+                if(BottomUp)
+                    BottomUp = frontierSize * Beta >= ids || frontierSize >= LastSize;
+                else if(frontierEdges * Alpha > ids)
+                {
+                    if(Unexplored == unknown())
+                        Unexplored = count();
+                    BottomUp = frontierSize > LastSize && frontierEdges * Alpha > Unexplored;
+                }
+                LastSize = frontierSize;
+            }
+    };
+
+    // Bitsets of a multi-source BFS(MS-BFS) over a batch of up to Lanes * 64 sources: one bit per source, Lanes words per vertex.
+    // The bitsets of a vertex tell which sources have reached it, and for which of them it is in the current or the next level,
+    // so a single scan of an edge advances the BFS of every source at once(the word loops are short enough to be vectorized).
+    template<std::size_t Lanes>
+    class source_bitsets
+    {
+        public:
+            std::vector<std::uint64_t> Seen;            // (id - sources that have reached it) mapping.
+            std::vector<std::uint64_t> Visit;           // (id - sources whose current level holds it) mapping.
+            std::vector<std::uint64_t> Next;            // (id - sources whose next level holds it) mapping.
+            std::vector<unsigned int> Frontier;         // Ids with a non-empty Visit.
+            std::vector<unsigned int> NextFrontier;     // Ids with a non-empty Next.
+
+            static constexpr std::size_t sources()
+            {
+                return Lanes * 64;
+            }
+
+            // Clears the bitsets for a new batch over ids in [0, n).
+            void prepare(std::size_t n)
+            {
+                Seen.assign(n * Lanes, 0);
+                Visit.assign(n * Lanes, 0);
+                Next.assign(n * Lanes, 0);
+                Frontier.clear();
+                NextFrontier.clear();
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef BICONNECTED_COMPONENTS_H
+#define BICONNECTED_COMPONENTS_H
+
+#include "undirected_graph.hpp"
+
+namespace graph
+{
+    // Biconnected decomposition of an undirected graph, found by a single Tarjan DFS that keeps two vertex stacks:
+    // one is cut into blocks(maximal biconnected subgraphs) at the articulation points, the other into 2-edge-connected
+    // components at the bridges. Cut vertices are the vertices in more than one block, and the block-cut tree links every
+    // block to the cut vertices it holds. Blocks and components are kept in CSR form, indexed by vertex id.
+    // The decomposition refers to the graph for the vertex labels, so the graph must outlive it. Later changes to the edges are not followed.
+    template<typename T, typename W>
+    class undirected_graph<T, W>::biconnected_components
+    {
+        friend class undirected_graph<T, W>;
+
+        private:
+            const undirected_graph<T, W> *_graph_{nullptr};
+            std::vector<unsigned int> _block_offsets_;                  // Block i holds _block_ids_[_block_offsets_[i], _block_offsets_[i + 1]).
+            std::vector<unsigned int> _block_ids_;
+            std::vector<unsigned int> _vertex_offsets_;                 // Vertex id is in the blocks _vertex_blocks_[_vertex_offsets_[id], _vertex_offsets_[id + 1]).
+            std::vector<unsigned int> _vertex_blocks_;
+            std::vector<unsigned int> _component_offsets_;              // 2-edge-connected component i holds _component_ids_[_component_offsets_[i], _component_offsets_[i + 1]).
+            std::vector<unsigned int> _component_ids_;
+            std::vector<unsigned int> _component_;                      // (id - 2-edge-connected component) mapping.
+            std::vector<std::pair<unsigned int, unsigned int>> _bridges_; // (parent, child) ids of the bridges, as met in the DFS tree.
+
+            // Given the graph, runs the decomposition.
+            explicit biconnected_components(const undirected_graph<T, W> &);
+
+            // Returns the id of the vertex, 0 if it is not a vertex of the graph.
+            unsigned int idOf(const T &) const;
+            // Returns the labels of Ids[first, last).
+            std::vector<T> labels(const std::vector<unsigned int> &, unsigned int, unsigned int) const;
+
+        public:
+            // Default constructor(an empty decomposition).
+            biconnected_components();
+
+            // Returns the blocks(biconnected components). A bridge is a block of two vertices, an isolated vertex a block of its own.
+            std::vector<std::vector<T>> blocks() const;
+            // Returns the cut vertices(articulation points).
+            std::vector<T> cutVertices() const;
+            // Returns the cut edges(bridges), as (parent, child) pairs of the DFS tree.
+            std::vector<std::pair<T, T>> bridges() const;
+            // Returns the 2-edge-connected components: the connected components left when the bridges are removed.
+            std::vector<std::vector<T>> twoEdgeConnectedComponents() const;
+            // Returns the edges of the block-cut tree(a forest, one tree per connected component) as (block index, cut vertex) pairs.
+            std::vector<std::pair<std::size_t, T>> blockCutTree() const;
+
+            // Given a vertex, returns the indices(into blocks()) of the blocks it belongs to. Only a cut vertex belongs to more than one.
+            std::vector<std::size_t> blocksOf(T) const;
+            // Given a vertex, returns true if it is a cut vertex, in O(1).
+            bool isCutVertex(T) const;
+            // Given two vertices, returns true if they are in the same 2-edge-connected component(no single edge separates them), in O(1).
+            bool twoEdgeConnected(T, T) const;
+
+            // Returns true if the decomposition is empty, else false.
+            bool empty() const;
+    };
+
+    template<typename T, typename W>
+    typename undirected_graph<T, W>::biconnected_components undirected_graph<T, W>::biconnectedComponents() const
+    {
+        return biconnected_components(*this);
+    }
+
+    template<typename T, typename W>
+    undirected_graph<T, W>::biconnected_components::biconnected_components()
+    {
+    }
+
+    template<typename T, typename W>
+    undirected_graph<T, W>::biconnected_components::biconnected_components(const undirected_graph<T, W> &G)
+        : _graph_ (&G)
+        , _block_offsets_ (1, 0)
+        , _component_offsets_ (1, 0)
+        , _component_ (G._id_, 0)
+    {
+        unsigned int id = 0;
+        std::vector<unsigned int> Ids(G._id_, 0);
+        std::vector<unsigned int> Low(G._id_, 0);
+        std::vector<unsigned int> BlockStack;           // Vertices whose block is not closed yet, in DFS order.
+        std::vector<unsigned int> ComponentStack;       // Vertices whose 2-edge-connected component is not closed yet, in DFS order.
+        dfs_stack Stack(G._id_);
+
+        // Moves the vertices above 'bottom'(itself included) from the stack to the ids of a new block or component.
+        auto close = [](std::vector<unsigned int> &From, unsigned int bottom, std::vector<unsigned int> &Ids, std::vector<unsigned int> &Offsets)
+        {
+            while(true)
+            {
+                unsigned int top = From.back();
+                From.pop_back();
+
+                Ids.push_back(top);
+                if(top == bottom)
+                    break;
+            }
+            Offsets.push_back(Ids.size());
+        };
+
+        for(unsigned int vertex = 1; vertex < G._id_; ++vertex)
+        {
+            if(!G.isVertex(vertex) || Stack.Visited[vertex])
+                continue;
+
+            std::size_t firstBlock = _block_offsets_.size();
+            G.depthFirstSearch(Stack, vertex, true, [&](unsigned int current, unsigned int)
+            {
+                Ids[current] = Low[current] = id++;
+                BlockStack.push_back(current);
+                ComponentStack.push_back(current);
+            },
+            [&](unsigned int current, unsigned int child)
+            {
+                // The edge is back-edge to one of the ancestors. Updating the low-link values using back-edges.
+                Low[current] = std::min(Low[current], Ids[child]);
+                return false;
+            },
+            [&](unsigned int child, unsigned int current)
+            {
+                if(current == 0)
+                    return;
+
+                // Propagating the low-link values to the parent.
+                Low[current] = std::min(Low[current], Low[child]);
+
+                // No back-edge from the subtree of 'child' goes above 'current': the subtree(down to 'child') and 'current' form a block.
+                // 'current' stays on the stack, as it may be in other blocks too.
+                if(Low[child] >= Ids[current])
+                {
+                    close(BlockStack, child, _block_ids_, _block_offsets_);
+                    _block_ids_.push_back(current);
+                    ++_block_offsets_.back();
+                }
+
+                // No back-edge from the subtree of 'child' reaches 'current' either: the edge is a bridge, and cuts off a 2-edge-connected component.
+                if(Low[child] > Ids[current])
+                {
+                    _bridges_.push_back(std::make_pair(current, child));
+                    close(ComponentStack, child, _component_ids_, _component_offsets_);
+                }
+            });
+
+            // Only the root is left on the stacks. It is a block of its own if it has no edges, and closes the last component.
+            if(_block_offsets_.size() == firstBlock)
+                close(BlockStack, vertex, _block_ids_, _block_offsets_);
+            else
+                BlockStack.pop_back();
+            close(ComponentStack, vertex, _component_ids_, _component_offsets_);
+        }
+
+        for(std::size_t i = 0; i + 1 < _component_offsets_.size(); ++i)
+            for(unsigned int j = _component_offsets_[i]; j < _component_offsets_[i + 1]; ++j)
+                _component_[_component_ids_[j]] = i;
+
+        // Blocks of every vertex, in CSR form.
+        _vertex_offsets_.assign(G._id_ + 1, 0);
+        for(unsigned int v : _block_ids_)
+            ++_vertex_offsets_[v + 1];
+        for(std::size_t v = 0; v < G._id_; ++v)
+            _vertex_offsets_[v + 1] += _vertex_offsets_[v];
+        _vertex_blocks_.resize(_block_ids_.size());
+        std::vector<unsigned int> Fill(_vertex_offsets_.begin(), _vertex_offsets_.end() - 1);
+        for(std::size_t i = 0; i + 1 < _block_offsets_.size(); ++i)
+            for(unsigned int j = _block_offsets_[i]; j < _block_offsets_[i + 1]; ++j)
+                _vertex_blocks_[Fill[_block_ids_[j]]++] = i;
+    }
+
+    template<typename T, typename W>
+    unsigned int undirected_graph<T, W>::biconnected_components::idOf(const T &vertex) const
+    {
+        if(_graph_ == nullptr)
+            return 0;
+
+        typename std::unordered_map<T, unsigned int>::const_iterator it = _graph_->_node_to_id_.find(vertex);
+        if(it == _graph_->_node_to_id_.end() || it->second >= _component_.size())
+            return 0;
+        return it->second;
+    }
+
+    template<typename T, typename W>
+    std::vector<T> undirected_graph<T, W>::biconnected_components::labels(const std::vector<unsigned int> &Ids, unsigned int first, unsigned int last) const
+    {
+        std::vector<T> Labels;
+        Labels.reserve(last - first);
+        for(unsigned int i = first; i < last; ++i)
+            Labels.push_back(_graph_->_id_to_node_[Ids[i]]);
+        return Labels;
+    }
+
+    template<typename T, typename W>
+    std::vector<std::vector<T>> undirected_graph<T, W>::biconnected_components::blocks() const
+    {
+        std::vector<std::vector<T>> Blocks;
+        for(std::size_t i = 0; i + 1 < _block_offsets_.size(); ++i)
+            Blocks.push_back(labels(_block_ids_, _block_offsets_[i], _block_offsets_[i + 1]));
+        return Blocks;
+    }
+
+    template<typename T, typename W>
+    std::vector<T> undirected_graph<T, W>::biconnected_components::cutVertices() const
+    {
+        std::vector<T> ArtPoints;
+        for(std::size_t id = 1; id + 1 < _vertex_offsets_.size(); ++id)
+            if(_vertex_offsets_[id + 1] - _vertex_offsets_[id] > 1)
+                ArtPoints.push_back(_graph_->_id_to_node_[id]);
+        return ArtPoints;
+    }
+
+    template<typename T, typename W>
+    std::vector<std::pair<T, T>> undirected_graph<T, W>::biconnected_components::bridges() const
+    {
+        std::vector<std::pair<T, T>> Bridges;
+        Bridges.reserve(_bridges_.size());
+        for(const std::pair<unsigned int, unsigned int> &edge : _bridges_)
+            Bridges.push_back(std::pair<T, T>(_graph_->_id_to_node_[edge.first], _graph_->_id_to_node_[edge.second]));
+        return Bridges;
+    }
+
+    template<typename T, typename W>
+    std::vector<std::vector<T>> undirected_graph<T, W>::biconnected_components::twoEdgeConnectedComponents() const
+    {
+        std::vector<std::vector<T>> Components;
+        for(std::size_t i = 0; i + 1 < _component_offsets_.size(); ++i)
+            Components.push_back(labels(_component_ids_, _component_offsets_[i], _component_offsets_[i + 1]));
+        return Components;
+    }
+
+    template<typename T, typename W>
+    std::vector<std::pair<std::size_t, T>> undirected_graph<T, W>::biconnected_components::blockCutTree() const
+    {
+        std::vector<std::pair<std::size_t, T>> Edges;
+        for(std::size_t i = 0; i + 1 < _block_offsets_.size(); ++i)
+            for(unsigned int j = _block_offsets_[i]; j < _block_offsets_[i + 1]; ++j)
+            {
+                unsigned int id = _block_ids_[j];
+                if(_vertex_offsets_[id + 1] - _vertex_offsets_[id] > 1)
+                    Edges.push_back(std::pair<std::size_t, T>(i, _graph_->_id_to_node_[id]));
+            }
+        return Edges;
+    }
+
+    template<typename T, typename W>
+    std::vector<std::size_t> undirected_graph<T, W>::biconnected_components::blocksOf(T vertex) const
+    {
+        unsigned int id = idOf(vertex);
+        if(id == 0)
+            return std::vector<std::size_t>();
+
+        return std::vector<std::size_t>(_vertex_blocks_.begin() + _vertex_offsets_[id], _vertex_blocks_.begin() + _vertex_offsets_[id + 1]);
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::biconnected_components::isCutVertex(T vertex) const
+    {
+        unsigned int id = idOf(vertex);
+        return id != 0 && _vertex_offsets_[id + 1] - _vertex_offsets_[id] > 1;
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::biconnected_components::twoEdgeConnected(T vertex1, T vertex2) const
+    {
+        unsigned int id1 = idOf(vertex1);
+        unsigned int id2 = idOf(vertex2);
+        if(id1 == 0 || id2 == 0 || _vertex_offsets_[id1 + 1] == _vertex_offsets_[id1] || _vertex_offsets_[id2 + 1] == _vertex_offsets_[id2])
+            return false;
+
+        return _component_[id1] == _component_[id2];
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::biconnected_components::empty() const
+    {
+        return _block_offsets_.size() <= 1;
+    }
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <utility>
+
+namespace graph
+{
+    // Monotone priority queues of (key, id) pairs with unsigned integral keys, for Dijkstra over integral weights.
+    // Monotone: a pushed key must not be smaller than the last popped key. Neither queue supports decrease-key,
+    // so the caller pushes a new pair and skips the stale ones when they are popped.
+
+    // Radix heap: bucket i holds the keys that first differ from the last popped key in bit i - 1.
+    // Every pair moves to a lower bucket at most once per bit, so n pushes and pops cost O(n log C).
+    template<typename Key = unsigned long long>
+    class radix_heap
+    {
+        private:
+            typedef std::pair<Key, unsigned int> pair;
+
+            std::vector<pair> _buckets_[std::numeric_limits<Key>::digits + 1];
+            Key _last_{0};
+            std::size_t _size_{0};
+
+            static unsigned int bitWidth(unsigned long long x)
+            {
+            #if defined(__GNUC__) || defined(__clang__)
+                return x == 0 ? 0 : std::numeric_limits<unsigned long long>::digits - __builtin_clzll(x);
+            #else
+                unsigned int width = 0;
+                for(; x != 0; x >>= 1)
+                    ++width;
+                return width;
+            #endif
+            }
+
+            unsigned int bucketOf(Key key) const
+            {
+                return bitWidth(key ^ _last_);
+            }
+
+        public:
+            bool empty() const
+            {
+                return _size_ == 0;
+            }
+
+            std::size_t size() const
+            {
+                return _size_;
+            }
+
+            void push(unsigned int id, Key key)
+            {
+                _buckets_[bucketOf(key)].push_back(pair(key, id));
+                ++_size_;
+            }
+
+            // Removes and returns a pair with the smallest key.
+            pair pop()
+            {
+                // Refill bucket 0 from the first non-empty bucket: its minimum becomes the new reference key.
+                if(_buckets_[0].empty())
+                {
+                    unsigned int i = 1;
+                    while(_buckets_[i].empty())
+                        ++i;
+
+                    _last_ = _buckets_[i].front().first;
+                    for(const pair &item : _buckets_[i])
+                        if(item.first < _last_)
+                            _last_ = item.first;
+
+                    for(const pair &item : _buckets_[i])
+                        _buckets_[bucketOf(item.first)].push_back(item);
+                    _buckets_[i].clear();
+                }
+
+                pair item = _buckets_[0].back();
+                _buckets_[0].pop_back();
+                --_size_;
+                return item;
+            }
+
+            // Empties the queue, keeping the capacity of the buckets.
+            void clear()
+            {
+                if(_size_ != 0)
+                    for(std::vector<pair> &bucket : _buckets_)
+                        bucket.clear();
+                _last_ = 0;
+                _size_ = 0;
+            }
+    };
+
+    // Dial's buckets: a circular array of maxWeight + 1 buckets, one per key. All the queued keys lie within
+    // [last popped key, last popped key + maxWeight], so they never collide. Push and pop are O(1) amortized.
+    template<typename Key = unsigned long long>
+    class dial_queue
+    {
+        private:
+            typedef std::pair<Key, unsigned int> pair;
+
+            std::vector<std::vector<pair>> _buckets_;
+            Key _current_{0};
+            std::size_t _size_{0};
+
+        public:
+            // Empties the queue and makes it ready for edges of weight up to maxWeight.
+            void reset(Key maxWeight)
+            {
+                if(_size_ != 0)
+                    for(std::vector<pair> &bucket : _buckets_)
+                        bucket.clear();
+                _buckets_.resize(static_cast<std::size_t>(maxWeight) + 1);
+                _current_ = 0;
+                _size_ = 0;
+            }
+
+            bool empty() const
+            {
+                return _size_ == 0;
+            }
+
+            std::size_t size() const
+            {
+                return _size_;
+            }
+
+            void push(unsigned int id, Key key)
+            {
+                _buckets_[key % _buckets_.size()].push_back(pair(key, id));
+                ++_size_;
+            }
+
+            // Removes and returns a pair with the smallest key.
+            pair pop()
+            {
+                while(_buckets_[_current_ % _buckets_.size()].empty())
+                    ++_current_;
+
+                std::vector<pair> &bucket = _buckets_[_current_ % _buckets_.size()];
+                pair item = bucket.back();
+                bucket.pop_back();
+                --_size_;
+                return item;
+            }
+    };
+}
+
+#endif
@@ -11,15 +11,17 @@ namespace graph
         friend class undirected_graph<T, W>;
 
         private:
-            typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator _it_;
+            typename std::vector<std::vector<Node<W>>>::const_iterator _it_;
             typename std::vector<Node<W>>::const_iterator _it2_;
-            std::unordered_map<unsigned int, T> const* _id_to_node_ptr_;                                                    // Pointer to const map.
-            typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator _last_it_;
+            typename std::vector<std::vector<Node<W>>>::const_iterator _last_it_;
+            typename std::vector<std::vector<Node<W>>>::const_iterator _first_it_;     // Iterator to the list of id 0, used to find the id of the current list.
+            std::vector<T> const* _id_to_node_ptr_;                                                    // Pointer to const map.
 
-            const_edge_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator &,    // Gives iterator to the adjacency list(current iterator).
-                                const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator &,    // Gives iterator to the last non-empty mapping in the container(used in bound checking, this is constant for a graph if not new edges are added).
-                                std::unordered_map<unsigned int, T> const*,                                                 // Reference to the _id_to_node_ in the graph.
-                                const typename std::vector<Node<W>>::const_iterator & = (std::vector<Node<W>>{}).begin());  // Gives iterator to the vector in the current mapping.
+            const_edge_iterator(const typename std::vector<std::vector<Node<W>>>::const_iterator &,    // Gives iterator to the adjacency list(current iterator).
+                                const typename std::vector<std::vector<Node<W>>>::const_iterator &,    // Gives iterator to the last non-empty list in the container(used in bound checking, this is constant for a graph if not new edges are added).
+                                const typename std::vector<std::vector<Node<W>>>::const_iterator &,    // Gives iterator to the first list in the container.
+                                std::vector<T> const*,                                                 // Reference to the _id_to_node_ in the graph.
+                                const typename std::vector<Node<W>>::const_iterator & = (std::vector<Node<W>>{}).begin());  // Gives iterator to the vector in the current list.
 
         public:
             /*
@@ -89,6 +91,7 @@ namespace graph
         : _it_ ( rhs._it_ )
         , _it2_ ( rhs._it2_ )
         , _last_it_ ( rhs._last_it_ )
+        , _first_it_ ( rhs._first_it_ )
         , _id_to_node_ptr_ ( rhs._id_to_node_ptr_ )
     {
     }
@@ -99,6 +102,7 @@ namespace graph
         _it_ = rhs._it_;
         _it2_ = rhs._it2_;
         _last_it_ = rhs._last_it_;
+        _first_it_ = rhs._first_it_;
         _id_to_node_ptr_ = rhs._id_to_node_ptr_;
         return *this;
     }
@@ -108,6 +112,7 @@ namespace graph
         : _it_ ( std::move(rhs._it_) )                          // Member-wise move phase.
         , _it2_ ( std::move(rhs._it2_) )
         , _last_it_ ( std::move(rhs._last_it_) )
+        , _first_it_ ( std::move(rhs._first_it_) )
         , _id_to_node_ptr_ ( std::move(rhs._id_to_node_ptr_) )
     {
         rhs._id_to_node_ptr_ = nullptr;                         // Reset phase.
@@ -122,6 +127,7 @@ namespace graph
         _it_ = std::move(rhs._it_);
         _it2_ = std::move(rhs._it2_);
         _last_it_ = std::move(rhs._last_it_);
+        _first_it_ = std::move(rhs._first_it_);
         _id_to_node_ptr_ = std::move(rhs._id_to_node_ptr_);
 
         // Reset phase.
@@ -135,6 +141,7 @@ namespace graph
         : _it_ ( rhs._it_ )
         , _it2_ ( rhs._it2_ )
         , _last_it_ ( rhs._last_it_ )
+        , _first_it_ ( rhs._first_it_ )
         , _id_to_node_ptr_ ( rhs._id_to_node_ptr_ )
     {
     }
@@ -144,6 +151,7 @@ namespace graph
         : _it_ ( std::move(rhs._it_) )                          // Member-wise move phase.
         , _it2_ ( std::move(rhs._it2_) )
         , _last_it_ ( std::move(rhs._last_it_) )
+        , _first_it_ ( std::move(rhs._first_it_) )
         , _id_to_node_ptr_ ( std::move(rhs._id_to_node_ptr_) )
     {
         rhs._id_to_node_ptr_ = nullptr;                         // Reset phase.
@@ -151,10 +159,11 @@ namespace graph
 
     // Private constructor. Only move version is sufficienct.
     template<typename T, typename W>
-    undirected_graph<T, W>::const_edge_iterator::const_edge_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator &rhs, const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator &rhs3, std::unordered_map<unsigned int, T> const* _id_to_node_, const typename std::vector<Node<W>>::const_iterator &rhs2)
+    undirected_graph<T, W>::const_edge_iterator::const_edge_iterator(const typename std::vector<std::vector<Node<W>>>::const_iterator &rhs, const typename std::vector<std::vector<Node<W>>>::const_iterator &rhs3, const typename std::vector<std::vector<Node<W>>>::const_iterator &rhs4, std::vector<T> const* _id_to_node_, const typename std::vector<Node<W>>::const_iterator &rhs2)
         : _it_ ( std::move(rhs) )                       // Member-wise move phase.
         , _it2_ ( std::move(rhs2) )
         , _last_it_ ( std::move(rhs3) )
+        , _first_it_ ( std::move(rhs4) )
         , _id_to_node_ptr_ ( std::move(_id_to_node_) )
     {
         _id_to_node_ = nullptr;                         // Reset phase.
@@ -175,14 +184,14 @@ namespace graph
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_edge_iterator& undirected_graph<T, W>::const_edge_iterator::operator++()
     {
-        // If it is not last non-empty mapping, but last element in current mapping, then goto next mapping.
-        if(_it2_ == _it_->second.end() - 1 && _it_ != _last_it_)
+        // If it is not last non-empty list, but last element in current list, then goto next list.
+        if(_it2_ == _it_->end() - 1 && _it_ != _last_it_)
         {
             ++_it_;
-            while(_it_->second.empty())
+            while(_it_->empty())
                 ++_it_;
 
-            _it2_ = _it_->second.begin();
+            _it2_ = _it_->begin();
         }
         else
             ++_it2_;
@@ -195,14 +204,14 @@ namespace graph
     {
         const_edge_iterator old = *this;
 
-        // If it is not last non-empty mapping, but last element in current mapping, then goto next mapping.
-        if(_it2_ == _it_->second.end() - 1 && _it_ != _last_it_)
+        // If it is not last non-empty list, but last element in current list, then goto next list.
+        if(_it2_ == _it_->end() - 1 && _it_ != _last_it_)
         {
             ++_it_;
-            while(_it_->second.empty())
+            while(_it_->empty())
                 ++_it_;
 
-            _it2_ = _it_->second.begin();
+            _it2_ = _it_->begin();
         }
         else
             ++_it2_;
@@ -213,13 +222,13 @@ namespace graph
     template<typename T, typename W>
     const std::pair<const T&, const T&> undirected_graph<T, W>::const_edge_iterator::operator*() const
     {
-        return std::make_pair( _id_to_node_ptr_->at(_it_->first), _id_to_node_ptr_->at(_it2_->vertex) );
+        return std::make_pair( (*_id_to_node_ptr_)[_it_ - _first_it_], (*_id_to_node_ptr_)[_it2_->vertex] );
     }
 
     template<typename T, typename W>
     const std::pair<const T*, const T*> undirected_graph<T, W>::const_edge_iterator::operator->() const
     {
-        return std::make_pair( &(_id_to_node_ptr_->at(_it_->first)), &(_id_to_node_ptr_->at(_it2_->vertex)) );
+        return std::make_pair( &((*_id_to_node_ptr_)[_it_ - _first_it_]), &((*_id_to_node_ptr_)[_it2_->vertex]) );
     }
 
     template<typename T, typename W>
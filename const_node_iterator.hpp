@@ -11,10 +11,11 @@ namespace graph
         friend class undirected_graph<T, W>;
 
         private:
-            typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator _it_;
-            std::unordered_map<unsigned int, T> const* _id_to_node_ptr_;        // Pointer to a constant map.
+            unsigned int _it_;                                  // Id of the current node.
+            std::vector<bool> const* _alive_ptr_;               // Used to skip the ids of removed nodes.
+            std::vector<T> const* _id_to_node_ptr_;             // Pointer to a constant vector.
 
-            const_node_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator &, std::unordered_map<unsigned int, T> const*);
+            const_node_iterator(unsigned int, std::vector<bool> const*, std::vector<T> const*);
 
         public:
             /*
@@ -76,6 +77,7 @@ namespace graph
     template<typename T, typename W>
     undirected_graph<T, W>::const_node_iterator::const_node_iterator(const const_node_iterator &rhs)
         : _it_ ( rhs._it_ )
+        , _alive_ptr_ ( rhs._alive_ptr_ )
         , _id_to_node_ptr_ ( rhs._id_to_node_ptr_ )
     {
     }
@@ -84,6 +86,7 @@ namespace graph
     typename undirected_graph<T, W>::const_node_iterator& undirected_graph<T, W>::const_node_iterator::operator=(const const_node_iterator &rhs)
     {
         _it_ = rhs._it_;
+        _alive_ptr_ = rhs._alive_ptr_;
         _id_to_node_ptr_ = rhs._id_to_node_ptr_;
         return *this;
     }
@@ -91,9 +94,11 @@ namespace graph
     template<typename T, typename W>
     undirected_graph<T, W>::const_node_iterator::const_node_iterator(const_node_iterator &&rhs) noexcept
         : _it_ ( std::move(rhs._it_) )                          // Member-wise move phase.
+        , _alive_ptr_ ( std::move(rhs._alive_ptr_) )
         , _id_to_node_ptr_ ( std::move(rhs._id_to_node_ptr_) )
     {
-        rhs._id_to_node_ptr_ = nullptr;                         // Reset phase.
+        rhs._alive_ptr_ = nullptr;                              // Reset phase.
+        rhs._id_to_node_ptr_ = nullptr;
     }
 
     template<typename T, typename W>
@@ -103,9 +108,11 @@ namespace graph
         
         // Member-wise move phase.
         _it_ = std::move(rhs._it_);
+        _alive_ptr_ = std::move(rhs._alive_ptr_);
         _id_to_node_ptr_ = std::move(rhs._id_to_node_ptr_);
         
         // Reset phase.
+        rhs._alive_ptr_ = nullptr;
         rhs._id_to_node_ptr_ = nullptr;
         return *this;
     }
@@ -113,6 +120,7 @@ namespace graph
     template<typename T, typename W>
     undirected_graph<T, W>::const_node_iterator::const_node_iterator(const typename undirected_graph<T, W>::node_iterator &rhs)
         : _it_ ( rhs._it_ )
+        , _alive_ptr_ ( rhs._alive_ptr_ )
         , _id_to_node_ptr_ ( rhs._id_to_node_ptr_ )
     {
     }
@@ -120,18 +128,26 @@ namespace graph
     template<typename T, typename W>
     undirected_graph<T, W>::const_node_iterator::const_node_iterator(typename undirected_graph<T, W>::node_iterator &&rhs) noexcept
         : _it_ ( std::move(rhs._it_) )
+        , _alive_ptr_ ( std::move(rhs._alive_ptr_) )
         , _id_to_node_ptr_ ( std::move(rhs._id_to_node_ptr_) )
     {
+        rhs._alive_ptr_ = nullptr;
         rhs._id_to_node_ptr_ = nullptr;
     }
 
     // Private constructor. Only move version is sufficienct.
     template<typename T, typename W>
-    undirected_graph<T, W>::const_node_iterator::const_node_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator &rhs, std::unordered_map<unsigned int, T> const* _id_to_node_)
-        : _it_ ( std::move(rhs) )                       // Member-wise move phase.
+    undirected_graph<T, W>::const_node_iterator::const_node_iterator(unsigned int rhs, std::vector<bool> const* _alive_, std::vector<T> const* _id_to_node_)
+        : _it_ ( rhs )                                  // Member-wise move phase.
+        , _alive_ptr_ ( std::move(_alive_) )
         , _id_to_node_ptr_ ( std::move(_id_to_node_) )
     {
-        _id_to_node_ = nullptr;                         // Reset phase.
+        _alive_ = nullptr;                              // Reset phase.
+        _id_to_node_ = nullptr;
+
+        // Skip the sentinel id 0 and the ids of removed nodes.
+        while(_it_ < _alive_ptr_->size() && !(*_alive_ptr_)[_it_])
+            ++_it_;
     }
 
     template<typename T, typename W>
@@ -149,7 +165,9 @@ namespace graph
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_node_iterator& undirected_graph<T, W>::const_node_iterator::operator++()
     {
-        ++_it_;
+        do
+            ++_it_;
+        while(_it_ < _alive_ptr_->size() && !(*_alive_ptr_)[_it_]);
         return *this;
     }
 
@@ -157,20 +175,20 @@ namespace graph
     typename undirected_graph<T, W>::const_node_iterator undirected_graph<T, W>::const_node_iterator::operator++(int)
     {
         const_node_iterator old = *this;
-        ++_it_;
+        ++(*this);
         return old;
     }
 
     template<typename T, typename W>
     const T& undirected_graph<T, W>::const_node_iterator::operator*() const
     {
-        return _id_to_node_ptr_->at(_it_->first);
+        return (*_id_to_node_ptr_)[_it_];
     }
 
     template<typename T, typename W>
     const T* undirected_graph<T, W>::const_node_iterator::operator->() const
     {
-        return &(_id_to_node_ptr_->at(_it_->first));
+        return &((*_id_to_node_ptr_)[_it_]);
     }
 }
 
@@ -0,0 +1,471 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include "undirected_graph.hpp"
+
+namespace graph
+{
+    // Static index over a snapshot of a graph for fast point-to-point shortest path queries.
+    // Preprocessing contracts the vertices one by one(least important first), adding a shortcut u -> w for every shortest path u -> v -> w
+    // through a contracted vertex v. A query is then a bidirectional Dijkstra that only climbs to more important vertices,
+    // and settles a tiny fraction of the graph. The hierarchy does not follow later changes to the graph.
+    template<typename T, typename W>
+    class undirected_graph<T, W>::contraction_hierarchy
+    {
+        friend class undirected_graph<T, W>;
+
+        private:
+            // An edge of the hierarchy. 'middle' is the contracted vertex a shortcut skips over, 0 for original edges.
+            class Arc
+            {
+                public:
+                    unsigned int vertex;
+                    distance_type weight;
+                    unsigned int middle;
+
+                    Arc(unsigned int v, distance_type w, unsigned int m) : vertex (v), weight (w), middle (m)
+                    {
+                    }
+            };
+
+            std::vector<T> _id_to_node_;
+            std::unordered_map<T, unsigned int> _node_to_id_;
+            std::vector<unsigned int> _rank_;               // (id - contraction order) mapping, higher is more important.
+
+            // Upward graph in CSR form. _UP_ holds the edges u -> w with rank[u] < rank[w], stored at u.
+            // _DOWN_ holds the edges u -> w with rank[u] > rank[w], stored reversed at w(Arc::vertex is u).
+            std::vector<std::size_t> _up_offsets_;
+            std::vector<Arc> _UP_;
+            std::vector<std::size_t> _down_offsets_;
+            std::vector<Arc> _DOWN_;
+            std::size_t _shortcuts_{0};
+
+            // A witness search gives up after settling this many vertices and keeps the shortcut. Priorities only need an estimate,
+            // so they use a much smaller limit. The shortcuts actually added use the full one.
+            static constexpr unsigned int _WITNESS_LIMIT_ = 500;
+            static constexpr unsigned int _ESTIMATE_LIMIT_ = 20;
+
+            // Given the graph, contracts all its vertices and lays out the upward graph.
+            explicit contraction_hierarchy(const undirected_graph<T, W> &);
+
+            // Given the out/in edges among the vertices not contracted yet, finds the shortcuts needed to contract the vertex, as (source id, edge) records.
+            // Witness searches settle at most the given number of vertices.
+            static void findShortcuts(unsigned int, const std::vector<std::vector<Arc>> &, const std::vector<std::vector<Arc>> &, search_workspace<distance_type> &, std::vector<std::pair<unsigned int, Arc>> &, unsigned int);
+            // Returns the priority of the vertex in the contraction order: (edge difference + contracted neighbours), lower is contracted first.
+            static int priority(unsigned int, const std::vector<std::vector<Arc>> &, const std::vector<std::vector<Arc>> &, const std::vector<int> &, search_workspace<distance_type> &, std::vector<std::pair<unsigned int, Arc>> &, unsigned int);
+            // Removes the edge to the given id from the list.
+            static void eraseArc(std::vector<Arc> &, unsigned int);
+            // Lowers the weight of the edge u -> w in the given lists, or adds it.
+            static void addArc(std::vector<Arc> &, unsigned int, distance_type, unsigned int);
+            // Returns the hierarchy edge from the first id to the second id.
+            const Arc& findArc(unsigned int, unsigned int) const;
+            // Runs the upward bidirectional search. Returns the id where the shortest path meets(0 if unreachable).
+            unsigned int search(search_workspace<distance_type> &, search_workspace<distance_type> &, unsigned int, unsigned int) const;
+            // Appends the original vertices of the hierarchy edge from the first id to the second id(excluding the first one) to the path.
+            void unpack(unsigned int, unsigned int, std::vector<T> &) const;
+
+        public:
+            // Default constructor(an empty hierarchy).
+            contraction_hierarchy();
+
+            /*
+             *  If the destination is not reachable, distance is inf.
+             *  If any of the vertex is invalid, distance is -1.
+             *  If the destination is not reachable || If any of the vertex is invalid, path is EMPTY VECTOR.
+             */
+            // Given two vertices, returns the length of shortest path between them.
+            double shortestDistance(T, T) const;
+            // Given two vertices, returns the shortest path between them.
+            std::vector<T> shortestPath(T, T) const;
+
+            // Returns true if the hierarchy has no vertices(e.g. it was built from a negative weighted graph).
+            bool empty() const;
+            // Returns the number of shortcut edges added by the preprocessing.
+            std::size_t shortcuts() const;
+    };
+
+    template<typename T, typename W>
+    typename undirected_graph<T, W>::contraction_hierarchy undirected_graph<T, W>::contractionHierarchy() const
+    {
+        // Shortcuts are only valid for non-negative weights.
+        if(isNegWeighted)
+            return contraction_hierarchy();
+
+        return contraction_hierarchy(*this);
+    }
+
+    template<typename T, typename W>
+    undirected_graph<T, W>::contraction_hierarchy::contraction_hierarchy()
+    {
+    }
+
+    template<typename T, typename W>
+    undirected_graph<T, W>::contraction_hierarchy::contraction_hierarchy(const undirected_graph<T, W> &G) : _id_to_node_ (G._id_to_node_), _node_to_id_ (G._node_to_id_)
+    {
+        unsigned int n = G._id_;
+        std::vector<std::vector<Arc>> Out(n);
+        std::vector<std::vector<Arc>> In(n);
+        search_workspace<distance_type> Witness;
+
+        // Copy the edges(an undirected edge becomes two arcs). Self loops are never on a shortest path.
+        for(unsigned int u = 1; u < n; ++u)
+        {
+            if(!G.isVertex(u))
+                continue;
+
+            for(const Node<W> &node : G.adjacent(u))
+            {
+                if(node.vertex == u)
+                    continue;
+                Out[u].push_back(Arc(node.vertex, node.weight, 0));
+                In[node.vertex].push_back(Arc(u, node.weight, 0));
+            }
+        }
+
+        // Parallel edges keep the lightest one, so every ordered pair has at most one edge.
+        for(std::vector<std::vector<Arc>> *Lists : {&Out, &In})
+            for(std::vector<Arc> &Arcs : *Lists)
+            {
+                std::sort(Arcs.begin(), Arcs.end(), [](const Arc &a, const Arc &b)
+                {
+                    return a.vertex < b.vertex || (a.vertex == b.vertex && a.weight < b.weight);
+                });
+                Arcs.erase(std::unique(Arcs.begin(), Arcs.end(), [](const Arc &a, const Arc &b)
+                {
+                    return a.vertex == b.vertex;
+                }), Arcs.end());
+            }
+
+        // Contract the vertices in the order of their priority. The neighbours of a contracted vertex are re-prioritised right away,
+        // other priorities may go stale and are checked again when the vertex reaches the top.
+        indexed_heap<int> Order;
+        std::vector<int> Deleted(n, 0);
+        std::vector<std::pair<unsigned int, Arc>> Shortcuts;
+        std::vector<unsigned int> Neighbours;
+        Order.reserve(n);
+        for(unsigned int v = 1; v < n; ++v)
+            if(G.isVertex(v))
+                Order.push(v, priority(v, Out, In, Deleted, Witness, Shortcuts, _ESTIMATE_LIMIT_));
+
+        // Out/In only keep the edges among the vertices not contracted yet. When a vertex is contracted, its remaining edges all lead to
+        // more important vertices: its out-edges become its upward edges and its in-edges its(reversed) downward edges.
+        std::vector<std::vector<Arc>> Up(n);
+        std::vector<std::vector<Arc>> Down(n);
+        _rank_.assign(n, 0);
+        unsigned int rank = 0;
+        while(!Order.empty())
+        {
+            unsigned int v = Order.pop();
+
+            // If the priority has grown past the next candidate, requeue the vertex.
+            int current = priority(v, Out, In, Deleted, Witness, Shortcuts, _ESTIMATE_LIMIT_);
+            if(!Order.empty() && current > Order.topKey())
+            {
+                Order.push(v, current);
+                continue;
+            }
+
+            findShortcuts(v, Out, In, Witness, Shortcuts, _WITNESS_LIMIT_);
+
+            for(const std::pair<unsigned int, Arc> &shortcut : Shortcuts)
+            {
+                addArc(Out[shortcut.first], shortcut.second.vertex, shortcut.second.weight, v);
+                addArc(In[shortcut.second.vertex], shortcut.first, shortcut.second.weight, v);
+            }
+            _shortcuts_ += Shortcuts.size();
+            _rank_[v] = ++rank;
+
+            Up[v].swap(Out[v]);
+            Down[v].swap(In[v]);
+            for(const Arc &arc : Up[v])
+                eraseArc(In[arc.vertex], v);
+            for(const Arc &arc : Down[v])
+                eraseArc(Out[arc.vertex], v);
+
+            // Re-prioritise each neighbour once(in an undirected graph it is both an out and an in neighbour).
+            Neighbours.clear();
+            for(const std::vector<Arc> *Arcs : {&Up[v], &Down[v]})
+                for(const Arc &arc : *Arcs)
+                    Neighbours.push_back(arc.vertex);
+            std::sort(Neighbours.begin(), Neighbours.end());
+            Neighbours.erase(std::unique(Neighbours.begin(), Neighbours.end()), Neighbours.end());
+
+            for(unsigned int neighbour : Neighbours)
+            {
+                ++Deleted[neighbour];
+                Order.changeKey(neighbour, priority(neighbour, Out, In, Deleted, Witness, Shortcuts, _ESTIMATE_LIMIT_));
+            }
+        }
+
+        // Lay out the upward and downward edges in CSR form.
+        _up_offsets_.assign(n + 1, 0);
+        _down_offsets_.assign(n + 1, 0);
+        for(unsigned int id = 0; id < n; ++id)
+        {
+            _up_offsets_[id + 1] = _up_offsets_[id] + Up[id].size();
+            _down_offsets_[id + 1] = _down_offsets_[id] + Down[id].size();
+        }
+
+        _UP_.clear();
+        _DOWN_.clear();
+        _UP_.reserve(_up_offsets_[n]);
+        _DOWN_.reserve(_down_offsets_[n]);
+        for(unsigned int id = 0; id < n; ++id)
+        {
+            _UP_.insert(_UP_.end(), Up[id].begin(), Up[id].end());
+            _DOWN_.insert(_DOWN_.end(), Down[id].begin(), Down[id].end());
+        }
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::contraction_hierarchy::findShortcuts(unsigned int v, const std::vector<std::vector<Arc>> &Out, const std::vector<std::vector<Arc>> &In, search_workspace<distance_type> &Witness, std::vector<std::pair<unsigned int, Arc>> &Shortcuts, unsigned int limit)
+    {
+        Shortcuts.clear();
+        distance_type maxOut = 0;
+        for(const Arc &arc : Out[v])
+            if(maxOut < arc.weight)
+                maxOut = arc.weight;
+
+        for(const Arc &source : In[v])
+        {
+            // Dijkstra from the source, around v, bounded by the longest path through v. It can stop as soon as all the targets are settled.
+            distance_type bound = source.weight + maxOut;
+            unsigned int settled = 0;
+            std::size_t pending = Out[v].size();
+            Witness.prepare(Out.size());
+            Witness.relax(source.vertex, 0, 0);
+            Witness.Heap.push(source.vertex, 0);
+
+            while(!Witness.Heap.empty() && Witness.Heap.topKey() <= bound && settled < limit)
+            {
+                unsigned int u = Witness.Heap.pop();
+                ++settled;
+
+                for(const Arc &target : Out[v])
+                    if(target.vertex == u)
+                        --pending;
+                if(pending == 0)
+                    break;
+
+                for(const Arc &arc : Out[u])
+                {
+                    if(arc.vertex == v)
+                        continue;
+
+                    distance_type newDist = Witness.Distance[u] + arc.weight;
+                    if(newDist < Witness.Distance[arc.vertex])
+                    {
+                        Witness.relax(arc.vertex, newDist, u);
+                        Witness.Heap.pushOrDecrease(arc.vertex, newDist);
+                    }
+                }
+            }
+
+            // Every target without a witness path at most as long as the one through v needs a shortcut.
+            for(const Arc &target : Out[v])
+            {
+                if(target.vertex == source.vertex)
+                    continue;
+
+                distance_type viaDist = source.weight + target.weight;
+                if(Witness.Distance[target.vertex] <= viaDist)
+                    continue;
+
+                Shortcuts.push_back(std::pair<unsigned int, Arc>(source.vertex, Arc(target.vertex, viaDist, v)));
+            }
+        }
+    }
+
+    template<typename T, typename W>
+    int undirected_graph<T, W>::contraction_hierarchy::priority(unsigned int v, const std::vector<std::vector<Arc>> &Out, const std::vector<std::vector<Arc>> &In, const std::vector<int> &Deleted, search_workspace<distance_type> &Witness, std::vector<std::pair<unsigned int, Arc>> &Shortcuts, unsigned int limit)
+    {
+        findShortcuts(v, Out, In, Witness, Shortcuts, limit);
+        return static_cast<int>(Shortcuts.size()) - static_cast<int>(Out[v].size() + In[v].size()) + Deleted[v];
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::contraction_hierarchy::eraseArc(std::vector<Arc> &Arcs, unsigned int vertex)
+    {
+        for(std::size_t i = 0; i < Arcs.size(); ++i)
+            if(Arcs[i].vertex == vertex)
+            {
+                Arcs[i] = Arcs.back();
+                Arcs.pop_back();
+                return;
+            }
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::contraction_hierarchy::addArc(std::vector<Arc> &Arcs, unsigned int vertex, distance_type weight, unsigned int middle)
+    {
+        for(Arc &arc : Arcs)
+        {
+            if(arc.vertex == vertex)
+            {
+                if(weight < arc.weight)
+                {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                }
+                return;
+            }
+        }
+        Arcs.push_back(Arc(vertex, weight, middle));
+    }
+
+    template<typename T, typename W>
+    const typename undirected_graph<T, W>::contraction_hierarchy::Arc& undirected_graph<T, W>::contraction_hierarchy::findArc(unsigned int u, unsigned int w) const
+    {
+        // There is one edge per ordered pair, stored at its lower ranked end.
+        if(_rank_[u] < _rank_[w])
+        {
+            for(std::size_t i = _up_offsets_[u]; ; ++i)
+                if(_UP_[i].vertex == w)
+                    return _UP_[i];
+        }
+        for(std::size_t i = _down_offsets_[w]; ; ++i)
+            if(_DOWN_[i].vertex == u)
+                return _DOWN_[i];
+    }
+
+    template<typename T, typename W>
+    unsigned int undirected_graph<T, W>::contraction_hierarchy::search(search_workspace<distance_type> &Forward, search_workspace<distance_type> &Backward, unsigned int start, unsigned int end) const
+    {
+        const distance_type inf = search_workspace<distance_type>::infinity();
+
+        Forward.prepare(_rank_.size());
+        Backward.prepare(_rank_.size());
+        Forward.relax(start, 0, 0);
+        Backward.relax(end, 0, 0);
+        Forward.Heap.push(start, 0);
+        Backward.Heap.push(end, 0);
+
+        distance_type best = inf;
+        unsigned int meet = 0;
+
+        while(true)
+        {
+            // A side is done once its smallest key cannot improve the best path found so far.
+            bool forwardLive = !Forward.Heap.empty() && Forward.Heap.topKey() < best;
+            bool backwardLive = !Backward.Heap.empty() && Backward.Heap.topKey() < best;
+            if(!forwardLive && !backwardLive)
+                break;
+
+            bool forward = forwardLive && (!backwardLive || Forward.Heap.topKey() <= Backward.Heap.topKey());
+            search_workspace<distance_type> &Self = forward ? Forward : Backward;
+            search_workspace<distance_type> &Other = forward ? Backward : Forward;
+            const std::vector<std::size_t> &Offsets = forward ? _up_offsets_ : _down_offsets_;
+            const std::vector<Arc> &Arcs = forward ? _UP_ : _DOWN_;
+
+            unsigned int vertex = Self.Heap.pop();
+            if(Other.Distance[vertex] != inf && Self.Distance[vertex] + Other.Distance[vertex] < best)
+            {
+                best = Self.Distance[vertex] + Other.Distance[vertex];
+                meet = vertex;
+            }
+
+            for(std::size_t i = Offsets[vertex]; i < Offsets[vertex + 1]; ++i)
+            {
+                distance_type newDist = Self.Distance[vertex] + Arcs[i].weight;
+                if(newDist < Self.Distance[Arcs[i].vertex])
+                {
+                    Self.relax(Arcs[i].vertex, newDist, vertex);
+                    Self.Heap.pushOrDecrease(Arcs[i].vertex, newDist);
+                }
+            }
+        }
+
+        return meet;
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::contraction_hierarchy::unpack(unsigned int u, unsigned int w, std::vector<T> &Path) const
+    {
+        // Replace each shortcut by its two halves until only original edges are left. Explicit stack, as hierarchies can be deep.
+        std::vector<std::pair<unsigned int, unsigned int>> Stack;
+        Stack.push_back(std::pair<unsigned int, unsigned int>(u, w));
+        while(!Stack.empty())
+        {
+            std::pair<unsigned int, unsigned int> edge = Stack.back();
+            Stack.pop_back();
+
+            unsigned int middle = findArc(edge.first, edge.second).middle;
+            if(middle == 0)
+                Path.push_back(_id_to_node_[edge.second]);
+            else
+            {
+                Stack.push_back(std::pair<unsigned int, unsigned int>(middle, edge.second));
+                Stack.push_back(std::pair<unsigned int, unsigned int>(edge.first, middle));
+            }
+        }
+    }
+
+    template<typename T, typename W>
+    double undirected_graph<T, W>::contraction_hierarchy::shortestDistance(T start, T end) const
+    {
+        // If any of the vertex is invalid, return -1.
+        if(_node_to_id_.find(start) == _node_to_id_.end() || _node_to_id_.find(end) == _node_to_id_.end())
+            return -1;
+
+
+        unsigned int s = _node_to_id_.at(start);
+        unsigned int e = _node_to_id_.at(end);
+
+        search_workspace<distance_type> &Forward = threadWorkspace<distance_type>(0);
+        search_workspace<distance_type> &Backward = threadWorkspace<distance_type>(1);
+        unsigned int meet = search(Forward, Backward, s, e);
+        if(meet == 0)
+            return std::numeric_limits<double>::infinity();
+        return static_cast<double>(Forward.Distance[meet]) + static_cast<double>(Backward.Distance[meet]);
+    }
+
+    template<typename T, typename W>
+    std::vector<T> undirected_graph<T, W>::contraction_hierarchy::shortestPath(T start, T end) const
+    {
+        // If any of the vertex is invalid, return empty vector.
+        if(_node_to_id_.find(start) == _node_to_id_.end() || _node_to_id_.find(end) == _node_to_id_.end())
+            return std::vector<T>();
+
+
+        unsigned int s = _node_to_id_.at(start);
+        unsigned int e = _node_to_id_.at(end);
+
+        search_workspace<distance_type> &Forward = threadWorkspace<distance_type>(0);
+        search_workspace<distance_type> &Backward = threadWorkspace<distance_type>(1);
+        unsigned int meet = search(Forward, Backward, s, e);
+        if(meet == 0)
+            return std::vector<T>();
+
+        // Up the forward search tree from the source to the meeting vertex, then down the backward one to the destination.
+        std::vector<unsigned int> Up;
+        for(unsigned int curr = meet; curr != s; curr = Forward.Prev[curr])
+            Up.push_back(curr);
+
+        std::vector<T> Path;
+        Path.push_back(_id_to_node_[s]);
+        unsigned int prev = s;
+        for(std::vector<unsigned int>::reverse_iterator it = Up.rbegin(); it != Up.rend(); ++it)
+        {
+            unpack(prev, *it, Path);
+            prev = *it;
+        }
+        for(unsigned int curr = meet; curr != e; curr = Backward.Prev[curr])
+            unpack(curr, Backward.Prev[curr], Path);
+
+        return Path;
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::contraction_hierarchy::empty() const
+    {
+        return _node_to_id_.empty();
+    }
+
+    template<typename T, typename W>
+    std::size_t undirected_graph<T, W>::contraction_hierarchy::shortcuts() const
+    {
+        return _shortcuts_;
+    }
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef DENSE_MATRIX_H
+#define DENSE_MATRIX_H
+
+#include <new>
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace graph
+{
+    // Allocator for std::vector whose blocks start on an 'Align' byte boundary(a cache line by default), so SIMD loads of a row never split a line.
+    template<typename V, std::size_t Align = 64>
+    class aligned_allocator
+    {
+        public:
+            typedef V value_type;
+
+            template<typename U>
+            struct rebind
+            {
+                typedef aligned_allocator<U, Align> other;
+            };
+
+            aligned_allocator() = default;
+
+            template<typename U>
+            aligned_allocator(const aligned_allocator<U, Align>&)
+            {
+            }
+
+            // Over-allocates by Align bytes and keeps the pointer returned by malloc just before the aligned block.
+            V* allocate(std::size_t n)
+            {
+                void *raw = std::malloc(n * sizeof(V) + Align + sizeof(void*));
+                if(raw == nullptr)
+                    throw std::bad_alloc();
+
+                std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + Align - 1) & ~static_cast<std::uintptr_t>(Align - 1);
+                reinterpret_cast<void**>(aligned)[-1] = raw;
+                return reinterpret_cast<V*>(aligned);
+            }
+
+            void deallocate(V *block, std::size_t)
+            {
+                if(block != nullptr)
+                    std::free(reinterpret_cast<void**>(block)[-1]);
+            }
+
+            template<typename U>
+            bool operator==(const aligned_allocator<U, Align>&) const
+            {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const aligned_allocator<U, Align>&) const
+            {
+                return false;
+            }
+    };
+
+    // Row-major matrix stored in one aligned block. Rows and columns are padded up to a multiple of 'Pad',
+    // so the matrix splits into whole Pad x Pad tiles and every row starts on a cache line.
+    template<typename V, std::size_t Pad = 64>
+    class dense_matrix
+    {
+        private:
+            std::size_t _size_{0};                              // Number of rows(and columns) in use.
+            std::size_t _stride_{0};                            // Padded number of rows(and columns).
+            std::vector<V, aligned_allocator<V>> _data_;
+
+        public:
+            dense_matrix() = default;
+
+            // A size x size matrix with every entry(padding included) set to 'value'.
+            dense_matrix(std::size_t size, const V &value)
+                : _size_(size)
+                , _stride_((size + Pad - 1) / Pad * Pad)
+                , _data_(_stride_ * _stride_, value)
+            {
+            }
+
+            std::size_t size() const
+            {
+                return _size_;
+            }
+
+            std::size_t stride() const
+            {
+                return _stride_;
+            }
+
+            // Side of the tiles the matrix splits into.
+            static std::size_t tile()
+            {
+                return Pad;
+            }
+
+            V* operator[](std::size_t row)
+            {
+                return _data_.data() + row * _stride_;
+            }
+
+            const V* operator[](std::size_t row) const
+            {
+                return _data_.data() + row * _stride_;
+            }
+    };
+
+    // One min-plus relaxation of a row segment of length n(a multiple of 8) through a common vertex, with the number of edges as a tie breaker:
+    //      if((a + B[j], min(ea + EB[j], cap)) < (C[j], E[j]))  C[j] = a + B[j], E[j] = min(ea + EB[j], cap), N[j] = hop
+    // This is the inner loop of Floyd-Warshall with next vertex tracking. Unreachable entries must have E[j] = 0, so that ties at infinity never win.
+    // The counts saturate at cap(at least the number of vertices, so the count of a simple path is exact): around a negative cycle they would
+    // otherwise keep adding up until they overflow. With counts of at most cap, the sum never does.
+    // Uses AVX-512 or AVX2 when the compiler targets them(e.g. -march=native).
+    inline void minPlusRow(double *C, std::int64_t *E, std::int64_t *N, const double *B, const std::int64_t *EB, double a, std::int64_t ea, std::int64_t hop, std::int64_t cap, std::size_t n)
+    {
+    #if defined(__AVX512F__)
+        __m512d va = _mm512_set1_pd(a);
+        __m512i vea = _mm512_set1_epi64(ea);
+        __m512i vhop = _mm512_set1_epi64(hop);
+        __m512i vcap = _mm512_set1_epi64(cap);
+        for(std::size_t j = 0; j < n; j += 8)
+        {
+            __m512d candidate = _mm512_add_pd(va, _mm512_load_pd(B + j));
+            __m512d current = _mm512_load_pd(C + j);
+            __m512i candidateEdges = _mm512_min_epi64(_mm512_add_epi64(vea, _mm512_load_si512(reinterpret_cast<const void*>(EB + j))), vcap);
+            __m512i currentEdges = _mm512_load_si512(reinterpret_cast<const void*>(E + j));
+            __mmask8 better = _mm512_cmp_pd_mask(candidate, current, _CMP_LT_OQ)
+                            | (_mm512_cmp_pd_mask(candidate, current, _CMP_EQ_OQ) & _mm512_cmplt_epi64_mask(candidateEdges, currentEdges));
+            if(better)
+            {
+                _mm512_store_pd(C + j, _mm512_mask_blend_pd(better, current, candidate));
+                _mm512_store_si512(reinterpret_cast<void*>(E + j), _mm512_mask_blend_epi64(better, currentEdges, candidateEdges));
+                __m512i next = _mm512_load_si512(reinterpret_cast<const void*>(N + j));
+                _mm512_store_si512(reinterpret_cast<void*>(N + j), _mm512_mask_blend_epi64(better, next, vhop));
+            }
+        }
+    #elif defined(__AVX2__)
+        __m256d va = _mm256_set1_pd(a);
+        __m256i vea = _mm256_set1_epi64x(ea);
+        __m256d vhop = _mm256_castsi256_pd(_mm256_set1_epi64x(hop));
+        __m256i vcap = _mm256_set1_epi64x(cap);
+        for(std::size_t j = 0; j < n; j += 4)
+        {
+            __m256d candidate = _mm256_add_pd(va, _mm256_load_pd(B + j));
+            __m256d current = _mm256_load_pd(C + j);
+            __m256i candidateEdges = _mm256_add_epi64(vea, _mm256_load_si256(reinterpret_cast<const __m256i*>(EB + j)));
+            candidateEdges = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(candidateEdges), _mm256_castsi256_pd(vcap),
+                                                                  _mm256_castsi256_pd(_mm256_cmpgt_epi64(candidateEdges, vcap))));
+            __m256i currentEdges = _mm256_load_si256(reinterpret_cast<const __m256i*>(E + j));
+            __m256d fewer = _mm256_castsi256_pd(_mm256_cmpgt_epi64(currentEdges, candidateEdges));
+            __m256d better = _mm256_or_pd(_mm256_cmp_pd(candidate, current, _CMP_LT_OQ), _mm256_and_pd(_mm256_cmp_pd(candidate, current, _CMP_EQ_OQ), fewer));
+            if(!_mm256_testz_pd(better, better))
+            {
+                _mm256_store_pd(C + j, _mm256_blendv_pd(current, candidate, better));
+                _mm256_store_pd(reinterpret_cast<double*>(E + j), _mm256_blendv_pd(_mm256_castsi256_pd(currentEdges), _mm256_castsi256_pd(candidateEdges), better));
+                __m256d next = _mm256_load_pd(reinterpret_cast<const double*>(N + j));
+                _mm256_store_pd(reinterpret_cast<double*>(N + j), _mm256_blendv_pd(next, vhop, better));
+            }
+        }
+    #else
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            double candidate = a + B[j];
+            std::int64_t candidateEdges = std::min(ea + EB[j], cap);
+            if(candidate < C[j] || (candidate == C[j] && candidateEdges < E[j]))
+            {
+                C[j] = candidate;
+                E[j] = candidateEdges;
+                N[j] = hop;
+            }
+        }
+    #endif
+    }
+
+    // Relaxes tile (bi, bj) of the distance matrix through every vertex of tile row/column bk, for blocked Floyd-Warshall:
+    //      D[i][j] = min(D[i][j], D[i][k] + D[k][j]),  E[i][j] = E[i][k] + E[k][j],  N[i][j] = N[i][k] when it improves
+    // Any of the three tiles may be the same one, the order of the loops keeps the in place updates correct. The edge counts saturate at cap.
+    template<std::size_t Pad>
+    void minPlusTile(dense_matrix<double, Pad> &D, dense_matrix<std::int64_t, Pad> &E, dense_matrix<std::int64_t, Pad> &N, std::int64_t cap, std::size_t bi, std::size_t bj, std::size_t bk)
+    {
+        for(std::size_t k = bk * Pad; k < (bk + 1) * Pad; ++k)
+        {
+            const double *Row = D[k] + bj * Pad;
+            const std::int64_t *RowEdges = E[k] + bj * Pad;
+            for(std::size_t i = bi * Pad; i < (bi + 1) * Pad; ++i)
+            {
+                double a = D[i][k];
+                if(a == std::numeric_limits<double>::infinity())
+                    continue;
+                minPlusRow(D[i] + bj * Pad, E[i] + bj * Pad, N[i] + bj * Pad, Row, RowEdges, a, E[i][k], N[i][k], cap, Pad);
+            }
+        }
+    }
+}
+
+#endif
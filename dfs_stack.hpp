@@ -0,0 +1,32 @@
+#ifndef DFS_STACK_H
+#define DFS_STACK_H
+
+#include <vector>
+#include <cstddef>
+
+namespace graph
+{
+    // State of an iterative depth first search: the frames a recursive DFS would keep on the call stack, and the visited marks.
+    // The marks are kept across searches, so one stack serves all the trees of a DFS forest.
+    class dfs_stack
+    {
+        public:
+            struct frame
+            {
+                unsigned int vertex;
+                unsigned int parent;            // 0 for the root of a tree.
+                std::size_t edge;               // Position of the next edge to follow in the adjacency list of the vertex.
+                bool parentSkipped;             // Whether the edge back to the parent has been passed over(undirected searches).
+            };
+
+            std::vector<frame> Frames;
+            std::vector<bool> Visited;          // (id - visited) mapping.
+
+            // A stack for ids in [0, n), with nothing visited.
+            explicit dfs_stack(std::size_t n) : Visited (n, false)
+            {
+            }
+    };
+}
+
+#endif
@@ -9,55 +9,68 @@ namespace graph
     int directed_graph<T, W>::isEulerian() const
     {
         // Empty graph is Eulerian.
-        if(this->_ADJACENCY_LIST_.empty())
+        if(this->empty())
             return 2;
 
-        // STEP-1: Check if all non-zero degree vertices are connected. If the number of SCC's with more than one node > 1 then graph is disconnected => not Eulerian. 
-        std::vector<std::vector<T>> SCC = stronglyConnectedComponents();
-        if(std::count_if(SCC.begin(), SCC.end(), [](std::vector<T> CC){ return (CC.size() > 1); }) > 1)
-            return 0;
-
-
-        // STEP-2: Finding the in-degree and out-degree of all the vertices.
-        unsigned numOfEdges = 0;
-        std::unordered_map<unsigned int, unsigned int> Indegree;
-        std::unordered_map<unsigned int, unsigned int> Outdegree;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
+        // STEP-1: Comparing the in-degree and out-degree of all the vertices.
+        std::size_t numOfEdges = 0;
+        unsigned int startCount = 0, endCount = 0;
+        unsigned int start = 0;
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            unsigned int id = adj_list.first;
-
-            int out_degree = adj_list.second.size();
-            int in_degree = 0;
-            for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list2 : this->_ADJACENCY_LIST_)
-            {
-                if(std::find(adj_list2.second.begin(), adj_list2.second.end(), id) != adj_list2.second.end())
-                    in_degree++;
-            }
+            if(!this->isVertex(id))
+                continue;
 
+            std::size_t out_degree = this->adjacent(id).size();
+            std::size_t in_degree = this->inAdjacent(id).size();
             numOfEdges += out_degree;
-            Indegree[id] = in_degree;
-            Outdegree[id] = out_degree;
+            if(out_degree > 0)
+                start = id;
+
+            if(out_degree > in_degree + 1 || in_degree > out_degree + 1)
+                return 0;
+            else if(out_degree == in_degree + 1)
+                startCount++;
+            else if(in_degree == out_degree + 1)
+                endCount++;
         }
         // If the graph has zero edges then it is Eulerian. 
         if(numOfEdges == 0)
             return 2;
 
         // Deciding whether Eulerian, Semi-Eulerian, not EUlerian.
-        unsigned int startCount = 0, endCount = 0;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
+        if(!((startCount == 0 && endCount == 0) || (startCount == 1 && endCount == 1)))
+            return 0;
+
+
+        // STEP-2: Check if all non-zero degree vertices are connected, ignoring the directions of the edges. With the degrees above
+        // that is enough for an Eulerian Path(or Cycle) to exist.
+        std::vector<bool> Visited(this->_id_, false);
+        std::vector<unsigned int> Stack(1, start);
+        Visited[start] = true;
+        while(!Stack.empty())
         {
-            unsigned int vertex = adj_list.first;
+            unsigned int current = Stack.back();
+            Stack.pop_back();
+            for(edge_range<W> Edges : {this->adjacent(current), this->inAdjacent(current)})
+            {
+                for(const Node<W> &node : Edges)
+                {
+                    if(!Visited[node.vertex])
+                    {
+                        Visited[node.vertex] = true;
+                        Stack.push_back(node.vertex);
+                    }
+                }
+            }
+        }
 
-            if(Outdegree[vertex] - Indegree[vertex] > 1 || Indegree[vertex] - Outdegree[vertex] > 1)
+        // If any vertex with an edge is unvisited now, it is not connected => not Eulerian.
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id) && !Visited[id] && this->adjacent(id).size() + this->inAdjacent(id).size() > 0)
                 return 0;
-            else if(Outdegree[vertex] - Indegree[vertex] == 1)
-                startCount++;
-            else if(Indegree[vertex] - Outdegree[vertex] == 1)
-                endCount++;
-        }
-        if(!((startCount == 0 && endCount == 0) || (startCount == 1 && endCount == 1)))
-            return 0;
-        
+
+        // Return 1 if it has Eulerian Path(Semi-Eulerian), 2 if it has Eulerian Cycle.
         return (startCount == 1 && endCount == 1) ? 1 : 2;
     }
 
@@ -65,69 +78,43 @@ namespace graph
     std::vector<T> directed_graph<T, W>::eulerianPath() const
     {
         // Return empty Eulerian Path for empty graph.
-        if(this->_ADJACENCY_LIST_.empty())
+        if(this->empty())
             return std::vector<T>();
 
-        // Finding the in-degree and out-degree of all the vertices.
-        unsigned numOfEdges = 0;
-        std::unordered_map<unsigned int, unsigned int> Indegree;
-        std::unordered_map<unsigned int, unsigned int> Outdegree;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
+        // Checking if the graph is Eulerian, and finding the starting node: the one with an extra out-edge, else any node with an out-edge.
+        std::size_t numOfEdges = 0;
+        unsigned int startCount = 0, endCount = 0;
+        unsigned int start = 0;
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            unsigned int id = adj_list.first;
-
-            int out_degree = adj_list.second.size();
-            int in_degree = 0;
-            for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list2 : this->_ADJACENCY_LIST_)
-            {
-                if(std::find(adj_list2.second.begin(), adj_list2.second.end(), id) != adj_list2.second.end())
-                    in_degree++;
-            }
+            if(!this->isVertex(id))
+                continue;
 
+            std::size_t out_degree = this->adjacent(id).size();
+            std::size_t in_degree = this->inAdjacent(id).size();
             numOfEdges += out_degree;
-            Indegree[id] = in_degree;
-            Outdegree[id] = out_degree;
-        }
-        if(numOfEdges == 0)
-            return std::vector<T>();
-
 
-        // Checking if the graph is Eulerian.
-        unsigned int startCount = 0, endCount = 0;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
-        {
-            unsigned int vertex = adj_list.first;
-
-            if(Outdegree[vertex] - Indegree[vertex] > 1 || Indegree[vertex] - Outdegree[vertex] > 1)
+            if(out_degree > in_degree + 1 || in_degree > out_degree + 1)
                 return std::vector<T>();
-            else if(Outdegree[vertex] - Indegree[vertex] == 1)
-                startCount++;
-            else if(Indegree[vertex] - Outdegree[vertex] == 1)
+            else if(out_degree == in_degree + 1)
+            {
+                if(startCount++ == 0)
+                    start = id;
+            }
+            else if(in_degree == out_degree + 1)
                 endCount++;
+            else if(out_degree > 0 && startCount == 0)
+                start = id;
         }
+        if(numOfEdges == 0)
+            return std::vector<T>();
         if(!((startCount == 0 && endCount == 0) || (startCount == 1 && endCount == 1)))
             return std::vector<T>();
 
 
-        // Finding the starting node for DFS.
-        unsigned int start;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
-        {
-            unsigned int vertex = adj_list.first;
-
-            if(Outdegree[vertex] - Indegree[vertex] == 1)
-            {
-                start = vertex;
-                break;
-            }
-            if(Outdegree[vertex] > 0)
-                start = vertex;
-        }
-
-
         // DFS.
         std::vector<T> Path;
-        eulerianPathUtil(start, Outdegree, Path);
+        eulerianPathUtil(start, Path);
         std::reverse(Path.begin(), Path.end());
 
         // If the graph is disconnected, Eulerian path doesn't exist.
@@ -137,22 +124,32 @@ namespace graph
         return Path;
     }
 
+    // Hierholzer's algorithm with an explicit stack: walk unused edges until stuck, then back up one vertex and add it to the path.
+    // The edges of a vertex are used from the back of its list, so a cursor per vertex is all the state the walk needs.
     template<typename T, typename W>
-    void directed_graph<T, W>::eulerianPathUtil(unsigned int current, std::unordered_map<unsigned int, unsigned int> &Outdegree, std::vector<T> &Path) const
+    void directed_graph<T, W>::eulerianPathUtil(unsigned int start, std::vector<T> &Path) const
     {
-        unsigned int &degree = Outdegree.at(current);
-        unsigned int next_edge;
+        std::vector<std::size_t> Cursor(this->_id_, 0);         // (id - number of unused out-edges) mapping.
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id))
+                Cursor[id] = this->adjacent(id).size();
 
-        // While the current node still has outgoing edges.
-        while(degree != 0)
+        std::vector<unsigned int> Stack(1, start);
+        while(!Stack.empty())
         {
-            // Select the next unvisited edge, mark it visited, continue DFS from that edge.
-            next_edge = this->_ADJACENCY_LIST_.at(current).at(--degree).vertex;
-            eulerianPathUtil(next_edge, Outdegree, Path);
-        }
+            unsigned int current = Stack.back();
+
+            // The current node has no outgoing edges left: add it to the solution.
+            if(Cursor[current] == 0)
+            {
+                Path.push_back(this->_id_to_node_[current]);
+                Stack.pop_back();
+                continue;
+            }
 
-        // Add current node to the solution.
-        Path.push_back(this->_id_to_node_.at(current));
+            // Select the next unvisited edge, mark it visited, continue from that edge.
+            Stack.push_back(this->adjacent(current)[--Cursor[current]].vertex);
+        }
     }
 };
 
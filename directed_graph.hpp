@@ -8,6 +8,24 @@ namespace graph
     template<typename T, typename W = int>
     class directed_graph : public undirected_graph<T, W>
     {
+        protected:
+            // In-edges of every vertex, indexed by id like _ADJACENCY_LIST_ (Node::vertex is the source of the edge).
+            // Kept in sync by every add/remove function, so in-degrees and predecessors never need a scan of all the lists.
+            std::vector<std::vector<Node<W>>> _REVERSE_ADJACENCY_LIST_;
+            // CSR snapshot of _REVERSE_ADJACENCY_LIST_. Valid only while the graph is frozen.
+            csr_adjacency<W> _REVERSE_CSR_;
+
+            // Given an object, returns its id. The object is added to the graph first, if it doesn't exist already.
+            unsigned int insertVertex(const T &);
+            // Given an id, removes the vertex and its in/out edges, leaving a tombstone in its place.
+            void eraseVertex(unsigned int);
+            // Returns the incoming edges of a vertex. Reads from the CSR snapshot when the graph is frozen.
+            edge_range<W> inAdjacent(unsigned int) const;
+            // Given the (source id, edge) records of new edges, writes them and their in-edges to the graph in one sorted pass.
+            void writeEdges(std::vector<std::pair<unsigned int, Node<W>>> &);
+            // Returns _REVERSE_ADJACENCY_LIST_.
+            std::vector<std::vector<Node<W>>>* reverseAdjacencyList();
+
         public:
             /*
              * SPECIAL MEMBER FUNCTIONS
@@ -31,6 +49,11 @@ namespace graph
             /*
              * NON-CONST MEMBER FUNCTIONS
              */
+            // Swaps the internal data structures of the given graphs.
+            void swap(directed_graph &);
+            // Clears the container.
+            void clear();
+
             // Given two objects, adds the edge between them to the graph, if it doesn't exist already.
             bool addEdge(T, T, W = 1);
             // Given a list of pair of objects, adds each edge to the graph, if it doesn't exist already.
@@ -47,15 +70,24 @@ namespace graph
             // Given a list of tuple of vertices and weights, removes each specified edge from the graph, if it exists.
             bool removeEdges(const std::vector<std::tuple<T, T, W>> &);
 
+            // Builds immutable CSR snapshots of the out-edges and the in-edges.
+            void freeze();
+            // Drops the CSR snapshots and makes the graph modifiable again.
+            void thaw();
 
 
             /*
              * CONST MEMBER FUNCTIONS
              */
-            // Returns the topological srt of the directed graph.
+            // Returns the topological srt of the directed graph. If the graph is cyclic, returns an empty vector.
             std::vector<T> topologicalSort() const;
+            // Returns the vertices grouped by level: a vertex with no in-edges is on level 0, any other one level below its deepest predecessor.
+            // Each level is extracted by the given number of threads(0 -> one per core), and lists its vertices in order of insertion.
+            // If the graph is cyclic, returns an empty vector.
+            std::vector<std::vector<T>> topologicalLevels(unsigned int threads = 0) const;
             // Returns a vector of vectors, where each vector contains vertices of a strongly connected component.
-            std::vector<std::vector<T>> stronglyConnectedComponents() const;
+            // Graphs of at least _PARALLEL_SCC_THRESHOLD_ vertices are decomposed by the given number of threads(0 -> one per core).
+            std::vector<std::vector<T>> stronglyConnectedComponents(unsigned int threads = 0) const;
 
             // Returns 0 -> Not Eulerian, 1 -> Semi-Eulerian, 2 -> Eulerian.
             int isEulerian() const;
@@ -70,13 +102,19 @@ namespace graph
         private:
             using undirected_graph<T, W>::cutEdges;
             using undirected_graph<T, W>::cutVertices;
+            using undirected_graph<T, W>::biconnectedComponents;
             using undirected_graph<T, W>::connectedComponents;
             using undirected_graph<T, W>::minimumSpanningTree;
 
-            unsigned int topologicalSortUtil(unsigned int, unsigned int, std::unordered_set<unsigned int> &, std::vector<T> &) const;
-            void stronglyConnectedComponentsUtil(unsigned int, unsigned int, std::stack<unsigned int> &, std::unordered_set<unsigned int> &, std::unordered_map<unsigned int, unsigned int> &, std::unordered_map<unsigned int, unsigned int> &, std::vector<std::vector<T>> &) const;
-            void eulerianPathUtil(unsigned int, std::unordered_map<unsigned int, unsigned int> &, std::vector<T> &) const;
-            bool isCyclicUtil(unsigned int, std::unordered_set<unsigned int> &, std::unordered_set<unsigned int> &, std::unordered_set<unsigned int> &) const;
+            void eulerianPathUtil(unsigned int, std::vector<T> &) const;
+
+            // Size below which a graph(or what is left of it) is decomposed by Tarjan's algorithm alone.
+            static constexpr std::size_t _PARALLEL_SCC_THRESHOLD_ = GRAPH_PARALLEL_SCC_THRESHOLD;
+            // Tarjan's algorithm over the vertices not visited in the stack yet. Appends the components to the vector.
+            void tarjan(dfs_stack &, std::vector<std::vector<T>> &) const;
+            // Trim, forward-backward and coloring steps of a parallel decomposition, given the number of threads. Appends the components it finds
+            // to the vector, and marks their vertices visited in the stack.
+            void parallelStronglyConnectedComponents(dfs_stack &, std::vector<std::vector<T>> &, unsigned int) const;
     };
 }
 
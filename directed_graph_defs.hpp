@@ -7,6 +7,7 @@ namespace graph
 {
     template<typename T, typename W>
     directed_graph<T, W>::directed_graph() noexcept
+        : _REVERSE_ADJACENCY_LIST_ ( 1 )    // Slot 0 belongs to the sentinel id.
     {
     }
 
@@ -15,12 +16,16 @@ namespace graph
     { 
         this->_ADJACENCY_LIST_.clear();
         this->_id_to_node_.clear();
+        this->_alive_.clear();
         this->_node_to_id_.clear(); 
+        this->_REVERSE_ADJACENCY_LIST_.clear();
     }
 
     template<typename T, typename W>
     directed_graph<T, W>::directed_graph(const directed_graph &rhs) noexcept
-        : graph::undirected_graph<T>(rhs)
+        : graph::undirected_graph<T, W>(rhs)
+        , _REVERSE_ADJACENCY_LIST_ ( rhs._REVERSE_ADJACENCY_LIST_ )
+        , _REVERSE_CSR_ ( rhs._REVERSE_CSR_ )
     {
     }
 
@@ -29,17 +34,26 @@ namespace graph
     {
         this->_ADJACENCY_LIST_ = rhs._ADJACENCY_LIST_;
         this->_id_to_node_ = rhs._id_to_node_;
+        this->_alive_ = rhs._alive_;
         this->_node_to_id_ = rhs._node_to_id_;
         this->isNegWeighted = rhs.isNegWeighted;
         this->isWeighted = rhs.isWeighted;
         this->_id_ = rhs._id_;
+        this->_CSR_ = rhs._CSR_;
+        this->_frozen_ = rhs._frozen_;
+        this->_NEIGHBOUR_INDEX_ = rhs._NEIGHBOUR_INDEX_;
+        this->_REVERSE_ADJACENCY_LIST_ = rhs._REVERSE_ADJACENCY_LIST_;
+        this->_REVERSE_CSR_ = rhs._REVERSE_CSR_;
         return *this;
     }
     
     template<typename T, typename W>
     directed_graph<T, W>::directed_graph(directed_graph &&rhs) noexcept
-        : graph::undirected_graph<T>(rhs)
+        : graph::undirected_graph<T, W>(std::move(rhs))
+        , _REVERSE_ADJACENCY_LIST_ ( std::move(rhs._REVERSE_ADJACENCY_LIST_) )
+        , _REVERSE_CSR_ ( std::move(rhs._REVERSE_CSR_) )
     {
+        rhs.clear();
     }
 
     template<typename T, typename W>
@@ -47,47 +61,123 @@ namespace graph
     {
         this->_ADJACENCY_LIST_ = std::move(rhs._ADJACENCY_LIST_);
         this->_id_to_node_ = std::move(rhs._id_to_node_);
+        this->_alive_ = std::move(rhs._alive_);
         this->_node_to_id_ = std::move(rhs._node_to_id_);
         this->isNegWeighted = std::move(rhs.isNegWeighted);
         this->isWeighted = std::move(rhs.isWeighted);
         this->_id_ = std::move(rhs._id_);
+        this->_CSR_ = std::move(rhs._CSR_);
+        this->_frozen_ = std::move(rhs._frozen_);
+        this->_NEIGHBOUR_INDEX_ = std::move(rhs._NEIGHBOUR_INDEX_);
+        this->_REVERSE_ADJACENCY_LIST_ = std::move(rhs._REVERSE_ADJACENCY_LIST_);
+        this->_REVERSE_CSR_ = std::move(rhs._REVERSE_CSR_);
+        rhs.clear();
         return *this;
     }
 
+    template<typename T, typename W>
+    void directed_graph<T, W>::swap(directed_graph &rhs)
+    {
+        undirected_graph<T, W>::swap(rhs);
+        this->_REVERSE_ADJACENCY_LIST_.swap(rhs._REVERSE_ADJACENCY_LIST_);
+        std::swap(this->_REVERSE_CSR_, rhs._REVERSE_CSR_);
+    }
+
+    template<typename T, typename W>
+    void directed_graph<T, W>::clear()
+    {
+        undirected_graph<T, W>::clear();
+        this->_REVERSE_ADJACENCY_LIST_.assign(1, std::vector<Node<W>>());
+        this->_REVERSE_CSR_.clear();
+    }
+
+    template<typename T, typename W>
+    unsigned int directed_graph<T, W>::insertVertex(const T &vertex)
+    {
+        unsigned int id = undirected_graph<T, W>::insertVertex(vertex);
+        if(id >= this->_REVERSE_ADJACENCY_LIST_.size())
+            this->_REVERSE_ADJACENCY_LIST_.resize(id + 1);
+
+        return id;
+    }
+
+    template<typename T, typename W>
+    void directed_graph<T, W>::eraseVertex(unsigned int id)
+    {
+        // Removing the in-edge records of the vertex's out-edges, and the out-edges of the vertices that lead to it. Only the lists of its
+        // neighbours have to be visited.
+        for(const Node<W> &node : this->_ADJACENCY_LIST_[id])
+        {
+            std::vector<Node<W>> &in_list = this->_REVERSE_ADJACENCY_LIST_[node.vertex];
+            in_list.erase(std::remove(in_list.begin(), in_list.end(), id), in_list.end());
+        }
+        for(const Node<W> &node : this->_REVERSE_ADJACENCY_LIST_[id])
+        {
+            this->eraseEdges(node.vertex, id);
+        }
+
+        // Removing from _node_to_id_ and leaving a tombstone in the per-vertex vectors.
+        this->_node_to_id_.erase(this->_id_to_node_[id]);
+        this->_alive_[id] = false;
+        this->_id_to_node_[id] = T();
+        std::vector<Node<W>>().swap(this->_ADJACENCY_LIST_[id]);
+        std::vector<Node<W>>().swap(this->_REVERSE_ADJACENCY_LIST_[id]);
+        this->_NEIGHBOUR_INDEX_.erase(id);
+    }
+
+    template<typename T, typename W>
+    edge_range<W> directed_graph<T, W>::inAdjacent(unsigned int id) const
+    {
+        if(this->_frozen_)
+            return this->_REVERSE_CSR_.neighbours(id);
+
+        const std::vector<Node<W>> &in_list = this->_REVERSE_ADJACENCY_LIST_[id];
+        return edge_range<W>(in_list.data(), in_list.data() + in_list.size());
+    }
+
+    template<typename T, typename W>
+    std::vector<std::vector<Node<W>>>* directed_graph<T, W>::reverseAdjacencyList()
+    {
+        return &this->_REVERSE_ADJACENCY_LIST_;
+    }
+
+    template<typename T, typename W>
+    void directed_graph<T, W>::freeze()
+    {
+        undirected_graph<T, W>::freeze();
+        this->_REVERSE_CSR_.build(this->_REVERSE_ADJACENCY_LIST_);
+    }
+
+    template<typename T, typename W>
+    void directed_graph<T, W>::thaw()
+    {
+        undirected_graph<T, W>::thaw();
+        this->_REVERSE_CSR_.clear();
+    }
+
     template<typename T, typename W>
     bool directed_graph<T, W>::addEdge(T vertex1, T vertex2, W weight)
     {
         try
         {
-            // If vertex1 is not previously there, add it to the list of nodes.
-            if(this->_node_to_id_.find(vertex1) == this->_node_to_id_.end())
-            {
-                this->_id_to_node_.insert(std::make_pair(this->_id_, vertex1));
-                this->_node_to_id_.insert(std::make_pair(vertex1, this->_id_));
-                this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                (this->_id_)++;
-            }
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
 
-            // If vertex2 is not previously there, add it to the list of nodes.
-            if(this->_node_to_id_.find(vertex2) == this->_node_to_id_.end())
-            {
-                this->_id_to_node_.insert(std::make_pair(this->_id_, vertex2));
-                this->_node_to_id_.insert(std::make_pair(vertex2, this->_id_));
-                this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                (this->_id_)++;
-            }
-
-            unsigned int id1 = this->_node_to_id_.at(vertex1);
-            unsigned int id2 = this->_node_to_id_.at(vertex2);
+            // If vertex1, vertex2 are not previously there, add them to the list of nodes.
+            unsigned int id1 = this->insertVertex(vertex1);
+            unsigned int id2 = this->insertVertex(vertex2);
 
             if(weight < 0)
                 this->isNegWeighted = true;
             if(weight != 1)
                 this->isWeighted = true;
 
-            std::vector<Node<W>> edge_list = this->_ADJACENCY_LIST_.at(id1);
-            if(std::find(edge_list.begin(), edge_list.end(), Node<W>{id2, weight}) == edge_list.end())
-                this->_ADJACENCY_LIST_.at(id1).push_back(Node<W>{id2, weight});
+            if(!this->hasEdge(id1, Node<W>{id2, weight}))
+            {
+                this->appendEdge(id1, Node<W>{id2, weight});
+                this->_REVERSE_ADJACENCY_LIST_[id2].push_back(Node<W>{id1, weight});
+            }
 
             return true;
         }
@@ -103,35 +193,24 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::pair<T, T> &e : edges)
             {
                 T vertex1 = e.first;
                 T vertex2 = e.second;
                 
-                // If vertex1 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex1) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex1));
-                    this->_node_to_id_.insert(std::make_pair(vertex1, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
-                }
+                // If vertex1, vertex2 are not previously there, add them to the list of nodes.
+                unsigned int id1 = this->insertVertex(vertex1);
+                unsigned int id2 = this->insertVertex(vertex2);
 
-                // If vertex2 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex2) == this->_node_to_id_.end())
+                if(!this->hasEdge(id1, id2))
                 {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex2));
-                    this->_node_to_id_.insert(std::make_pair(vertex2, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
+                    this->appendEdge(id1, Node<W>{id2});
+                    this->_REVERSE_ADJACENCY_LIST_[id2].push_back(Node<W>{id1});
                 }
-
-                unsigned int id1 = this->_node_to_id_.at(vertex1);
-                unsigned int id2 = this->_node_to_id_.at(vertex2);
-
-                std::vector<Node<W>> edge_list = this->_ADJACENCY_LIST_.at(id1);
-                if(std::find(edge_list.begin(), edge_list.end(), id2) == edge_list.end())
-                    this->_ADJACENCY_LIST_.at(id1).push_back(Node<W>{id2});
             }
 
             return true;
@@ -148,41 +227,30 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::tuple<T, T, W> &e : edges)
             {
                 T vertex1 = std::get<0>(e);
                 T vertex2 = std::get<1>(e);
                 W weight = std::get<2>(e);
 
-                // If vertex1 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex1) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex1));
-                    this->_node_to_id_.insert(std::make_pair(vertex1, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
-                }
-
-                // If vertex2 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex2) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex2));
-                    this->_node_to_id_.insert(std::make_pair(vertex2, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
-                }
-
-                unsigned int id1 = this->_node_to_id_.at(vertex1);
-                unsigned int id2 = this->_node_to_id_.at(vertex2);
+                // If vertex1, vertex2 are not previously there, add them to the list of nodes.
+                unsigned int id1 = this->insertVertex(vertex1);
+                unsigned int id2 = this->insertVertex(vertex2);
 
                 if(weight < 0)
                     this->isNegWeighted = true;
                 if(weight != 1)
                     this->isWeighted = true;
 
-                std::vector<Node<W>> edge_list = this->_ADJACENCY_LIST_.at(id1);
-                if(std::find(edge_list.begin(), edge_list.end(), Node<W>{id2, weight}) == edge_list.end())
-                    this->_ADJACENCY_LIST_.at(id1).push_back(Node<W>{id2, weight});
+                if(!this->hasEdge(id1, Node<W>{id2, weight}))
+                {
+                    this->appendEdge(id1, Node<W>{id2, weight});
+                    this->_REVERSE_ADJACENCY_LIST_[id2].push_back(Node<W>{id1, weight});
+                }
             }
 
             return true;
@@ -194,18 +262,46 @@ namespace graph
         }    
     }
 
+    template<typename T, typename W>
+    void directed_graph<T, W>::writeEdges(std::vector<std::pair<unsigned int, Node<W>>> &records)
+    {
+        this->sortEdges(records);
+        this->appendSortedEdges(records);
+
+        // Only the edges which were actually added are left in the records. They are sorted by source, so the in-edge lists come out sorted too.
+        std::vector<std::size_t> InDegree(this->_REVERSE_ADJACENCY_LIST_.size(), 0);
+        for(const std::pair<unsigned int, Node<W>> &record : records)
+            ++InDegree[record.second.vertex];
+        for(std::size_t id = 0; id < InDegree.size(); ++id)
+            if(InDegree[id] > 0)
+                this->_REVERSE_ADJACENCY_LIST_[id].reserve(this->_REVERSE_ADJACENCY_LIST_[id].size() + InDegree[id]);
+
+        for(const std::pair<unsigned int, Node<W>> &record : records)
+            this->_REVERSE_ADJACENCY_LIST_[record.second.vertex].push_back(Node<W>{record.first, record.second.weight});
+    }
+
     template<typename T, typename W>
     bool directed_graph<T, W>::removeEdge(T vertex1, T vertex2)
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             if(this->_node_to_id_.find(vertex1) != this->_node_to_id_.end() && this->_node_to_id_.find(vertex2) != this->_node_to_id_.end())
             {
+                unsigned int id1 = this->_node_to_id_.at(vertex1);
+                unsigned int id2 = this->_node_to_id_.at(vertex2);
+
                 // Remove vertex2 from adjacency list of vertex1.
-                std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(this->_node_to_id_.at(vertex1));
-                if(std::find(edge_list1.begin(), edge_list1.end(), this->_node_to_id_.at(vertex2)) != edge_list1.end())
+                if(this->hasEdge(id1, id2))
                 {
-                    edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), this->_node_to_id_.at(vertex2)), edge_list1.end());
+                    this->eraseEdges(id1, id2);
+
+                    // Remove vertex1 from the in-edges of vertex2.
+                    std::vector<Node<W>> &in_list2 = this->_REVERSE_ADJACENCY_LIST_[id2];
+                    in_list2.erase(std::remove(in_list2.begin(), in_list2.end(), id1), in_list2.end());
                 }
 
                 this->checkGraph();
@@ -225,6 +321,10 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::pair<T, T> &e : edges)
             {
                 T vertex1 = e.first;
@@ -232,11 +332,17 @@ namespace graph
     
                 if(this->_node_to_id_.find(vertex1) != this->_node_to_id_.end() && this->_node_to_id_.find(vertex2) != this->_node_to_id_.end())
                 {
+                    unsigned int id1 = this->_node_to_id_.at(vertex1);
+                    unsigned int id2 = this->_node_to_id_.at(vertex2);
+
                     // Remove vertex2 from adjacency list of vertex1.
-                    std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(this->_node_to_id_.at(vertex1));
-                    if(std::find(edge_list1.begin(), edge_list1.end(), this->_node_to_id_.at(vertex2)) != edge_list1.end())
+                    if(this->hasEdge(id1, id2))
                     {
-                        edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), this->_node_to_id_.at(vertex2)), edge_list1.end());
+                        this->eraseEdges(id1, id2);
+
+                        // Remove vertex1 from the in-edges of vertex2.
+                        std::vector<Node<W>> &in_list2 = this->_REVERSE_ADJACENCY_LIST_[id2];
+                        in_list2.erase(std::remove(in_list2.begin(), in_list2.end(), id1), in_list2.end());
                     }
 
                     this->checkGraph();
@@ -257,13 +363,23 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             if(this->_node_to_id_.find(vertex1) != this->_node_to_id_.end() && this->_node_to_id_.find(vertex2) != this->_node_to_id_.end())
             {
+                unsigned int id1 = this->_node_to_id_.at(vertex1);
+                unsigned int id2 = this->_node_to_id_.at(vertex2);
+
                 // Remove vertex2 from adjacency list of vertex1.
-                std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(this->_node_to_id_.at(vertex1));
-                if(std::find(edge_list1.begin(), edge_list1.end(), Node<W>{this->_node_to_id_.at(vertex2), weight}) != edge_list1.end())
+                if(this->hasEdge(id1, Node<W>{id2, weight}))
                 {
-                    edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), Node<W>{this->_node_to_id_.at(vertex2), weight}), edge_list1.end());
+                    this->eraseEdge(id1, Node<W>{id2, weight});
+
+                    // Remove vertex1 from the in-edges of vertex2.
+                    std::vector<Node<W>> &in_list2 = this->_REVERSE_ADJACENCY_LIST_[id2];
+                    in_list2.erase(std::remove(in_list2.begin(), in_list2.end(), Node<W>{id1, weight}), in_list2.end());
                 }
 
                 this->checkGraph();
@@ -283,6 +399,10 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::tuple<T, T, W> &e : edges)
             {
                 T vertex1 = std::get<0>(e);
@@ -291,11 +411,17 @@ namespace graph
 
                 if(this->_node_to_id_.find(vertex1) != this->_node_to_id_.end() && this->_node_to_id_.find(vertex2) != this->_node_to_id_.end())
                 {
+                    unsigned int id1 = this->_node_to_id_.at(vertex1);
+                    unsigned int id2 = this->_node_to_id_.at(vertex2);
+
                     // Remove vertex2 from adjacency list of vertex1.
-                    std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(this->_node_to_id_.at(vertex1));
-                    if(std::find(edge_list1.begin(), edge_list1.end(), Node<W>{this->_node_to_id_.at(vertex2), weight}) != edge_list1.end())
+                    if(this->hasEdge(id1, Node<W>{id2, weight}))
                     {
-                        edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), Node<W>{this->_node_to_id_.at(vertex2), weight}), edge_list1.end());
+                        this->eraseEdge(id1, Node<W>{id2, weight});
+
+                        // Remove vertex1 from the in-edges of vertex2.
+                        std::vector<Node<W>> &in_list2 = this->_REVERSE_ADJACENCY_LIST_[id2];
+                        in_list2.erase(std::remove(in_list2.begin(), in_list2.end(), Node<W>{id1, weight}), in_list2.end());
                     }
 
                     this->checkGraph();
@@ -312,64 +438,277 @@ namespace graph
     }
 
     template<typename T, typename W>
-    std::vector<std::vector<T>> directed_graph<T, W>::stronglyConnectedComponents() const
+    std::vector<std::vector<T>> directed_graph<T, W>::stronglyConnectedComponents(unsigned int threads) const
     {
-        unsigned int id = 0;
-        std::stack<unsigned int> S;
+        if(threads == 0)
+            threads = defaultThreads();
+
         std::vector<std::vector<T>> SCC;
-        std::unordered_set<unsigned int> onStack;
-        std::unordered_map<unsigned int, unsigned int> Ids; // This also acts as 'Visited' array.
-        std::unordered_map<unsigned int, unsigned int> Low;
+        dfs_stack Stack(this->_id_);
+        if(threads > 1 && this->_node_to_id_.size() >= _PARALLEL_SCC_THRESHOLD_)
+            parallelStronglyConnectedComponents(Stack, SCC, threads);
 
-        // A SCC is a subtree in a DFS tree. So, start DFS for every tree in DFS forest to find all SCC's.
-        for(const std::pair<unsigned int, T> &vertex : this->_id_to_node_)
-            if(Ids.find(vertex.first) == Ids.end())
-                stronglyConnectedComponentsUtil(vertex.first, id, S, onStack, Ids, Low, SCC);
-            
+        // Tarjan's algorithm finds the components the parallel steps left(all of them, if they did not run).
+        tarjan(Stack, SCC);
         return SCC;
     }
 
+    // Multistep SCC(Slota, Rajamanickam and Madduri), in three steps:
+    // 1. Trim: a vertex with no in-edges or no out-edges among the remaining vertices is a component of its own. Removing it may expose more,
+    //    so trimming goes on in rounds until none is left. On graphs with many trivial components(e.g. call graphs) this takes most of the vertices.
+    // 2. Forward-backward: the vertices that are both reachable from a pivot and reach it form its component. The pivot is the vertex with the
+    //    largest in-degree * out-degree, which is likely in the giant component, so two parallel BFS remove the giant component.
+    // 3. Coloring: every remaining vertex takes the largest id that reaches it(propagated along out-edges). A vertex that keeps its own id is a root,
+    //    and the vertices of its color that reach it form its component. The components of all the roots are searched at once.
+    // Coloring repeats until fewer than _PARALLEL_SCC_THRESHOLD_ vertices are left, or a pass is too slow or assigns less than 1/8 of them.
+    // The vertices already assigned are marked visited in the stack, so that Tarjan's algorithm only searches the rest.
     template<typename T, typename W>
-    void directed_graph<T, W>::stronglyConnectedComponentsUtil(unsigned int current, unsigned int id, std::stack<unsigned int> &S, std::unordered_set<unsigned int> &onStack, std::unordered_map<unsigned int, unsigned int> &Ids, std::unordered_map<unsigned int, unsigned int> &Low, std::vector<std::vector<T>> &SCC) const
+    void directed_graph<T, W>::parallelStronglyConnectedComponents(dfs_stack &Stack, std::vector<std::vector<T>> &SCC, unsigned int threads) const
     {
-        // As soon as a node is visited, push it onto the stack and assign it an id and a low-link value.
-        S.push(current);
-        onStack.insert(current);
-        Ids[current] = Low[current] = id++;
+        unsigned int n = this->_id_;
+        vertex_bitmap Done;                                     // Ids assigned to a component(and the ids that are not vertices).
+        Done.reset(n);
+        std::vector<std::vector<unsigned int>> Local(threads);  // Ids each thread collected.
+        std::vector<unsigned int> Work;
+
+        // Moves the ids in Local to the end of the given list.
+        auto gather = [&Local](std::vector<unsigned int> &Ids)
+        {
+            for(std::vector<unsigned int> &Collected : Local)
+            {
+                Ids.insert(Ids.end(), Collected.begin(), Collected.end());
+                Collected.clear();
+            }
+        };
 
-        // Loop through all the neighbours of the current node.
-        for(const Node<W> &next : this->_ADJACENCY_LIST_.at(current))
+        // STEP-1: Trim. In and Out count the in-edges and out-edges(self loops aside) between a vertex and the vertices not trimmed yet.
+        std::vector<std::atomic<unsigned int>> In(n);
+        std::vector<std::atomic<unsigned int>> Out(n);
+        parallelFor(n, threads, [&](unsigned int t, std::size_t first, std::size_t last)
         {
-            // Do DFS for unvisited nodes.
-            if(Ids.find(next.vertex) == Ids.end())
-                stronglyConnectedComponentsUtil(next.vertex, id, S, onStack, Ids, Low, SCC);
-            
-            // If the 'next' is on the stack, it means that there is a path from 'next' to 'current' which we used to visit 'current'. But now there is also a path from 'current' to 'next'.
-            // So, 'current', 'next' belong to same SCC. This step allows low-link values to propagate throughout cycles.
-            if(onStack.find(next.vertex) != onStack.end())
-                Low[current] = std::min(Low[current], Low[next.vertex]);
+            for(std::size_t id = first; id < last; ++id)
+            {
+                if(!this->isVertex(id))
+                {
+                    Done.claim(id);
+                    continue;
+                }
+
+                unsigned int in = 0, out = 0;
+                for(const Node<W> &node : this->inAdjacent(id))
+                    in += node.vertex != id;
+                for(const Node<W> &node : this->adjacent(id))
+                    out += node.vertex != id;
+                In[id].store(in, std::memory_order_relaxed);
+                Out[id].store(out, std::memory_order_relaxed);
+
+                if((in == 0 || out == 0) && Done.claim(id))
+                    Local[t].push_back(id);
+            }
+        });
+        gather(Work);
+
+        // Every trimmed vertex passes through Work once. It no longer counts towards the degrees of its neighbours.
+        std::vector<std::vector<unsigned int>> Trimmed(threads);
+        parallelRounds(Work, threads, [&](unsigned int t, std::size_t, unsigned int vertex, std::vector<unsigned int> &Next)
+        {
+            Trimmed[t].push_back(vertex);
+            for(const Node<W> &node : this->adjacent(vertex))
+                if(node.vertex != vertex && In[node.vertex].fetch_sub(1, std::memory_order_relaxed) == 1 && Done.claim(node.vertex))
+                    Next.push_back(node.vertex);
+            for(const Node<W> &node : this->inAdjacent(vertex))
+                if(node.vertex != vertex && Out[node.vertex].fetch_sub(1, std::memory_order_relaxed) == 1 && Done.claim(node.vertex))
+                    Next.push_back(node.vertex);
+        });
+        for(const std::vector<unsigned int> &Ids : Trimmed)
+            for(unsigned int id : Ids)
+                SCC.push_back(std::vector<T>(1, this->_id_to_node_[id]));
+
+        // STEP-2: Forward-backward from the remaining vertex with the most in-edges * out-edges among the remaining vertices.
+        std::vector<std::pair<unsigned long long, unsigned int>> Best(threads, std::make_pair(0ULL, 0U));
+        parallelFor(n, threads, [&](unsigned int t, std::size_t first, std::size_t last)
+        {
+            for(std::size_t id = first; id < last; ++id)
+                if(!Done.test(id))
+                    Best[t] = std::max(Best[t], std::make_pair((unsigned long long)In[id].load(std::memory_order_relaxed) * Out[id].load(std::memory_order_relaxed), (unsigned int)id));
+        });
+        unsigned int pivot = std::max_element(Best.begin(), Best.end())->second;
+        // Every vertex was trimmed.
+        if(pivot == 0)
+        {
+            Stack.Visited.assign(n, true);
+            return;
         }
 
-        // If the low-link value is equal to the id for a node, it is the start of a SCC.
-        if(Ids[current] == Low[current])
+        vertex_bitmap Forward;
+        Forward.reset(n);
+        Forward.claim(pivot);
+        Work.assign(1, pivot);
+        parallelRounds(Work, threads, [&](unsigned int, std::size_t, unsigned int vertex, std::vector<unsigned int> &Next)
+        {
+            for(const Node<W> &node : this->adjacent(vertex))
+                if(!Done.test(node.vertex) && !Forward.test(node.vertex) && Forward.claim(node.vertex))
+                    Next.push_back(node.vertex);
+        });
+
+        // The backward search stays inside the forward set, so it only reaches the component of the pivot.
+        std::vector<unsigned int> Component;
+        Done.claim(pivot);
+        Work.assign(1, pivot);
+        parallelRounds(Work, threads, [&](unsigned int t, std::size_t, unsigned int vertex, std::vector<unsigned int> &Next)
+        {
+            Local[t].push_back(vertex);
+            for(const Node<W> &node : this->inAdjacent(vertex))
+                if(Forward.test(node.vertex) && !Done.test(node.vertex) && Done.claim(node.vertex))
+                    Next.push_back(node.vertex);
+        });
+        gather(Component);
+        SCC.push_back(std::vector<T>());
+        for(unsigned int id : Component)
+            SCC.back().push_back(this->_id_to_node_[id]);
+
+        // STEP-3: Coloring.
+        std::vector<unsigned int> Remaining;
+        for(unsigned int id = 1; id < n; ++id)
+            if(!Done.test(id))
+                Remaining.push_back(id);
+
+        std::vector<std::atomic<unsigned int>> Color(n);
+        std::vector<std::atomic<std::size_t>> Queued(n);        // (id - round + 1 it was last queued for) mapping.
+        std::vector<unsigned int> Slot(n, 0);                   // (root - position of its component in SCC) mapping.
+        while(Remaining.size() >= _PARALLEL_SCC_THRESHOLD_)
         {
-            // Finding the component by popping off the stack until the start node(current).
-            std::vector<T> Component;
-            while(true)
+            for(unsigned int id : Remaining)
+            {
+                Color[id].store(id, std::memory_order_relaxed);
+                Queued[id].store(0, std::memory_order_relaxed);
+            }
+
+            // A vertex is queued again whenever its color grows, until no color changes. Colors can take as many rounds as the longest path
+            // to settle, so a pass that visits more than 16 times the vertices per thread is given up.
+            std::vector<std::size_t> Visits(threads, 0);
+            std::atomic<bool> givenUp(false);
+            std::size_t budget = 16 * Remaining.size() / threads;
+            Work = Remaining;
+            parallelRounds(Work, threads, [&](unsigned int t, std::size_t round, unsigned int vertex, std::vector<unsigned int> &Next)
             {
-                unsigned int top = S.top();
-                S.pop();
+                if(givenUp.load(std::memory_order_relaxed))
+                    return;
+                if(++Visits[t] > budget)
+                {
+                    givenUp.store(true, std::memory_order_relaxed);
+                    return;
+                }
 
-                Component.push_back(this->_id_to_node_.at(top));
-                onStack.erase(top);
-                Low[top] = Ids[current];
-                if(top == current) 
+                unsigned int color = Color[vertex].load(std::memory_order_relaxed);
+                for(const Node<W> &node : this->adjacent(vertex))
                 {
-                    SCC.push_back(Component);
-                    break;
+                    if(Done.test(node.vertex))
+                        continue;
+
+                    unsigned int old = Color[node.vertex].load(std::memory_order_relaxed);
+                    while(old < color && !Color[node.vertex].compare_exchange_weak(old, color, std::memory_order_relaxed));
+                    if(old < color && Queued[node.vertex].exchange(round + 1, std::memory_order_relaxed) != round + 1)
+                        Next.push_back(node.vertex);
                 }
+            });
+
+            if(givenUp.load(std::memory_order_relaxed))
+                break;
+
+            // Backward searches from all the roots at once, each inside its own color.
+            for(unsigned int id : Remaining)
+            {
+                if(Color[id].load(std::memory_order_relaxed) != id)
+                    continue;
+
+                Done.claim(id);
+                Work.push_back(id);
+                Slot[id] = SCC.size();
+                SCC.push_back(std::vector<T>());
             }
+            parallelRounds(Work, threads, [&](unsigned int t, std::size_t, unsigned int vertex, std::vector<unsigned int> &Next)
+            {
+                Local[t].push_back(vertex);
+                unsigned int color = Color[vertex].load(std::memory_order_relaxed);
+                for(const Node<W> &node : this->inAdjacent(vertex))
+                    if(!Done.test(node.vertex) && Color[node.vertex].load(std::memory_order_relaxed) == color && Done.claim(node.vertex))
+                        Next.push_back(node.vertex);
+            });
+            for(const std::vector<unsigned int> &Ids : Local)
+                for(unsigned int id : Ids)
+                    SCC[Slot[Color[id].load(std::memory_order_relaxed)]].push_back(this->_id_to_node_[id]);
+            for(std::vector<unsigned int> &Ids : Local)
+                Ids.clear();
+
+            // A pass that assigns few vertices(e.g. on a long chain of small cycles, where only the top of the chain keeps its color) is
+            // not worth repeating: Tarjan's algorithm takes the rest in linear time.
+            std::size_t left = Remaining.size();
+            Remaining.erase(std::remove_if(Remaining.begin(), Remaining.end(), [&Done](unsigned int id) { return Done.test(id); }), Remaining.end());
+            if((left - Remaining.size()) * 8 < left)
+                break;
         }
+
+        for(unsigned int id = 1; id < n; ++id)
+            Stack.Visited[id] = Done.test(id);
+    }
+
+    template<typename T, typename W>
+    void directed_graph<T, W>::tarjan(dfs_stack &Stack, std::vector<std::vector<T>> &SCC) const
+    {
+        unsigned int id = 0;
+        std::vector<unsigned int> S;
+        std::vector<bool> onStack(this->_id_, false);
+        std::vector<unsigned int> Ids(this->_id_, 0);
+        std::vector<unsigned int> Low(this->_id_, 0);
+
+        // A SCC is a subtree in a DFS tree. So, start DFS for every tree in DFS forest to find all SCC's.
+        for(unsigned int vertex = 1; vertex < this->_id_; ++vertex)
+        {
+            if(!this->isVertex(vertex) || Stack.Visited[vertex])
+                continue;
+
+            this->depthFirstSearch(Stack, vertex, false, [&](unsigned int current, unsigned int)
+            {
+                // As soon as a node is visited, push it onto the stack and assign it an id and a low-link value.
+                S.push_back(current);
+                onStack[current] = true;
+                Ids[current] = Low[current] = id++;
+            },
+            [&](unsigned int current, unsigned int next)
+            {
+                // If the 'next' is on the stack, there is a path from 'next' to 'current' which we used to visit 'current'. But now there is also a path from 'current' to 'next'.
+                // So, 'current', 'next' belong to same SCC.
+                if(onStack[next])
+                    Low[current] = std::min(Low[current], Ids[next]);
+                return false;
+            },
+            [&](unsigned int current, unsigned int parent)
+            {
+                // If the low-link value is equal to the id for a node, it is the start of a SCC.
+                if(Ids[current] == Low[current])
+                {
+                    // Finding the component by popping off the stack until the start node(current).
+                    std::vector<T> Component;
+                    while(true)
+                    {
+                        unsigned int top = S.back();
+                        S.pop_back();
+
+                        Component.push_back(this->_id_to_node_[top]);
+                        onStack[top] = false;
+                        if(top == current)
+                            break;
+                    }
+                    SCC.push_back(Component);
+                }
+
+                // This step allows low-link values to propagate throughout cycles(a finished SCC has a larger low-link than its parent).
+                if(parent != 0)
+                    Low[parent] = std::min(Low[parent], Low[current]);
+            });
+        }
+
     }
 
     // Different method for finding cycles in a directed graph. This is based on detecting back-edges in DFS forest.
@@ -412,76 +751,112 @@ namespace graph
     //     return false;
     // }
 
+    // There is a cycle only if the DFS finds an edge back to a vertex that is not completely processed(an ancestor on the current path).
     template<typename T, typename W>
     bool directed_graph<T, W>::isCyclic() const
     {
-        std::unordered_set<unsigned int> whiteSet;      // Unvisited
-        std::unordered_set<unsigned int> greySet;       // Visited, but not completely processed.
-        std::unordered_set<unsigned int> blackSet;      // Visited completely.
-
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &i : this->_ADJACENCY_LIST_)
-            whiteSet.insert(i.first);
-        
-        while(whiteSet.size() > 0)
+        std::vector<bool> Grey(this->_id_, false);      // Visited, but not completely processed.
+        dfs_stack Stack(this->_id_);
+
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            if(isCyclicUtil(*whiteSet.begin(), whiteSet, greySet, blackSet))
+            if(!this->isVertex(id) || Stack.Visited[id])
+                continue;
+
+            if(this->depthFirstSearch(Stack, id, false, [&](unsigned int current, unsigned int) { Grey[current] = true; },
+                                      [&](unsigned int, unsigned int next) { return Grey[next]; },
+                                      [&](unsigned int current, unsigned int) { Grey[current] = false; }))
                 return true;
         }
-        
+
         return false;
     }
 
+    // Kahn's algorithm: a vertex is placed once all its predecessors are placed. A cycle is the only thing that leaves vertices unplaced.
     template<typename T, typename W>
-    bool directed_graph<T, W>::isCyclicUtil(unsigned int start, std::unordered_set<unsigned int> &whiteSet, std::unordered_set<unsigned int> &greySet, std::unordered_set<unsigned int> &blackSet) const
+    std::vector<T> directed_graph<T, W>::topologicalSort() const
     {
-        greySet.insert(start);
-        whiteSet.erase(start);
-
-        for(Node<W> dest : this->_ADJACENCY_LIST_.at(start))
+        std::vector<unsigned int> In(this->_id_, 0);        // (id - number of unplaced predecessors) mapping.
+        std::vector<unsigned int> Order;                    // Placed ids, read in order as a queue.
+        Order.reserve(this->_node_to_id_.size());
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            if(blackSet.find(dest.vertex) != blackSet.end())
+            if(!this->isVertex(id))
                 continue;
-            if(greySet.find(dest.vertex) != greySet.end())
-                return true;
-            if(whiteSet.find(dest.vertex) != whiteSet.end() && isCyclicUtil(dest.vertex, whiteSet, greySet, blackSet))
-                return true;
+
+            In[id] = this->inAdjacent(id).size();
+            if(In[id] == 0)
+                Order.push_back(id);
         }
 
-        greySet.erase(start);
-        blackSet.insert(start);
-        return false;
-    }
+        for(std::size_t i = 0; i < Order.size(); ++i)
+            for(const Node<W> &node : this->adjacent(Order[i]))
+                if(--In[node.vertex] == 0)
+                    Order.push_back(node.vertex);
 
-    template<typename T, typename W>
-    std::vector<T> directed_graph<T, W>::topologicalSort() const
-    {
-        if(isCyclic())
+        if(Order.size() != this->_node_to_id_.size())
             return std::vector<T>{};
 
-        std::unordered_set<unsigned int> Visited;
-        unsigned int index = this->_ADJACENCY_LIST_.size() - 1;
-        std::vector<T> TopSort(index + 1);
-
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
-            if(Visited.find(edges.first) == Visited.end())
-                index = topologicalSortUtil(index, edges.first, Visited, TopSort);
+        std::vector<T> TopSort;
+        TopSort.reserve(Order.size());
+        for(unsigned int id : Order)
+            TopSort.push_back(this->_id_to_node_[id]);
 
         return TopSort;
     }
 
+    // Kahn's algorithm one level per round: the threads share the vertices of a level, and a vertex joins the next level when the thread
+    // that places its last predecessor brings its counter to 0. The levels are then listed by id, so the result does not depend on the threads.
     template<typename T, typename W>
-    unsigned int directed_graph<T, W>::topologicalSortUtil(unsigned int index, unsigned int start, std::unordered_set<unsigned int> &Visited, std::vector<T> &TopSort) const
+    std::vector<std::vector<T>> directed_graph<T, W>::topologicalLevels(unsigned int threads) const
     {
-        Visited.insert(start);
+        const unsigned int unplaced = std::numeric_limits<unsigned int>::max();
+        std::vector<std::atomic<unsigned int>> In(this->_id_);     // (id - number of unplaced predecessors) mapping.
+        std::vector<unsigned int> Level(this->_id_, unplaced);    // (id - level) mapping.
+        std::vector<unsigned int> Work;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+        {
+            if(!this->isVertex(id))
+                continue;
+
+            unsigned int in_degree = this->inAdjacent(id).size();
+            In[id].store(in_degree, std::memory_order_relaxed);
+            if(in_degree == 0)
+                Work.push_back(id);
+        }
 
-        for(Node<W> dest : this->_ADJACENCY_LIST_.at(start))
-            if(Visited.find(dest.vertex) == Visited.end())
-                index = topologicalSortUtil(index, dest.vertex, Visited, TopSort);
+        parallelRounds(Work, threads, [&](unsigned int, std::size_t round, unsigned int id, std::vector<unsigned int> &Next)
+        {
+            Level[id] = round;
+            for(const Node<W> &node : this->adjacent(id))
+                if(In[node.vertex].fetch_sub(1, std::memory_order_relaxed) == 1)
+                    Next.push_back(node.vertex);
+        });
+
+        // Counting sort of the ids by level. An unplaced vertex lies on a cycle, or after one.
+        std::vector<std::size_t> Size;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+        {
+            if(!this->isVertex(id))
+                continue;
+            if(Level[id] == unplaced)
+                return std::vector<std::vector<T>>{};
+
+            if(Level[id] >= Size.size())
+                Size.resize(Level[id] + 1, 0);
+            Size[Level[id]]++;
+        }
 
-        TopSort[index] = this->_id_to_node_.at(start);
-        return index - 1;
+        std::vector<std::vector<T>> Levels(Size.size());
+        for(std::size_t level = 0; level < Size.size(); ++level)
+            Levels[level].reserve(Size[level]);
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id))
+                Levels[Level[id]].push_back(this->_id_to_node_[id]);
+
+        return Levels;
     }
-    
+
     template<typename T, typename W>
     std::pair<int, int> directed_graph<T, W>::degree(T vertex) const
     {
@@ -489,13 +864,8 @@ namespace graph
         {
             unsigned int id = this->_node_to_id_.at(vertex);
 
-            int out_degree = this->_ADJACENCY_LIST_.at(id).size();
-            int in_degree = 0;
-            for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
-            {
-                if(std::find(edges.second.begin(), edges.second.end(), id) != edges.second.end())
-                    in_degree++;
-            }
+            int out_degree = this->_ADJACENCY_LIST_[id].size();
+            int in_degree = this->_REVERSE_ADJACENCY_LIST_[id].size();
 
             return std::pair<int, int>(in_degree, out_degree);
         }
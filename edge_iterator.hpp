@@ -11,15 +11,23 @@ namespace graph
         friend class undirected_graph<T, W>;
 
         private:
-            typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator _it_;
+            typename std::vector<std::vector<Node<W>>>::iterator _it_;
             typename std::vector<Node<W>>::iterator _it2_;
-            std::unordered_map<unsigned int, T> *_id_to_node_ptr_;
-            typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator _last_it_;
-
-            edge_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator &,    // Gives iterator to the adjacency list(current iterator).
-                          const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator &,    // Gives iterator to the last non-empty mapping in the container(used in bound checking, this is constant for a graph if not new edges are added).
-                          std::unordered_map<unsigned int, T> *,                                                // Reference to the _id_to_node_ in the graph.
-                          const typename std::vector<Node<W>>::iterator & = (std::vector<Node<W>>{}).begin());  // Gives iterator to the vector in the current mapping.
+            typename std::vector<std::vector<Node<W>>>::iterator _last_it_;
+            typename std::vector<std::vector<Node<W>>>::iterator _first_it_;     // Iterator to the list of id 0, used to find the id of the current list.
+            std::vector<T> *_id_to_node_ptr_;
+            bool const* _frozen_ptr_;
+            std::vector<std::vector<Node<W>>> *_reverse_ptr_;     // In-edge lists of a directed graph(nullptr for undirected graphs).
+            std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>> *_index_ptr_;     // Neighbour index of the high-degree vertices.
+
+            edge_iterator(const typename std::vector<std::vector<Node<W>>>::iterator &,    // Gives iterator to the adjacency list(current iterator).
+                          const typename std::vector<std::vector<Node<W>>>::iterator &,    // Gives iterator to the last non-empty list in the container(used in bound checking, this is constant for a graph if not new edges are added).
+                          const typename std::vector<std::vector<Node<W>>>::iterator &,    // Gives iterator to the first list in the container.
+                          std::vector<T> *,                                                // Reference to the _id_to_node_ in the graph.
+                          bool const*,                                                                          // Reference to the _frozen_ flag in the graph(weights of a frozen graph cannot be changed).
+                          std::vector<std::vector<Node<W>>> *,                                                  // Reference to the in-edge lists which mirror the weights, if any.
+                          std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>> *,                         // Reference to the _NEIGHBOUR_INDEX_ in the graph(it also stores the weights).
+                          const typename std::vector<Node<W>>::iterator & = (std::vector<Node<W>>{}).begin());  // Gives iterator to the vector in the current list.
 
         public:
             /*
@@ -83,7 +91,11 @@ namespace graph
         : _it_ ( rhs._it_ )
         , _it2_ ( rhs._it2_ )
         , _last_it_ ( rhs._last_it_ )
+        , _first_it_ ( rhs._first_it_ )
         , _id_to_node_ptr_ ( rhs._id_to_node_ptr_ )
+        , _frozen_ptr_ ( rhs._frozen_ptr_ )
+        , _reverse_ptr_ ( rhs._reverse_ptr_ )
+        , _index_ptr_ ( rhs._index_ptr_ )
     {
     }
     
@@ -93,7 +105,11 @@ namespace graph
         _it_ = rhs._it_;
         _it2_ = rhs._it2_;
         _last_it_ = rhs._last_it_;
+        _first_it_ = rhs._first_it_;
         _id_to_node_ptr_ = rhs._id_to_node_ptr_;
+        _frozen_ptr_ = rhs._frozen_ptr_;
+        _reverse_ptr_ = rhs._reverse_ptr_;
+        _index_ptr_ = rhs._index_ptr_;
         return *this;
     }
 
@@ -102,9 +118,16 @@ namespace graph
         : _it_ ( std::move(rhs._it_) )                          // Member-wise move phase.
         , _it2_ ( std::move(rhs._it2_) )
         , _last_it_ ( std::move(rhs._last_it_) )
+        , _first_it_ ( std::move(rhs._first_it_) )
         , _id_to_node_ptr_ ( std::move(rhs._id_to_node_ptr_) )
+        , _frozen_ptr_ ( std::move(rhs._frozen_ptr_) )
+        , _reverse_ptr_ ( std::move(rhs._reverse_ptr_) )
+        , _index_ptr_ ( std::move(rhs._index_ptr_) )
     {
         rhs._id_to_node_ptr_ = nullptr;                         // Reset phase.
+        rhs._frozen_ptr_ = nullptr;
+        rhs._reverse_ptr_ = nullptr;
+        rhs._index_ptr_ = nullptr;
     }
     
     template<typename T, typename W>
@@ -116,23 +139,37 @@ namespace graph
         _it_ = std::move(rhs._it_);
         _it2_ = std::move(rhs._it2_);
         _last_it_ = std::move(rhs._last_it_);
+        _first_it_ = std::move(rhs._first_it_);
         _id_to_node_ptr_ = std::move(rhs._id_to_node_ptr_);
+        _frozen_ptr_ = std::move(rhs._frozen_ptr_);
+        _reverse_ptr_ = std::move(rhs._reverse_ptr_);
+        _index_ptr_ = std::move(rhs._index_ptr_);
 
         // Reset phase.
         rhs._id_to_node_ptr_ = nullptr;
+        rhs._frozen_ptr_ = nullptr;
+        rhs._reverse_ptr_ = nullptr;
+        rhs._index_ptr_ = nullptr;
 
         return *this;
     }
 
     // Private constructor. Only move version is sufficienct.
     template<typename T, typename W>
-    undirected_graph<T, W>::edge_iterator::edge_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator &rhs, const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator &rhs3, std::unordered_map<unsigned int, T> *_id_to_node_, const typename std::vector<Node<W>>::iterator &rhs2)
+    undirected_graph<T, W>::edge_iterator::edge_iterator(const typename std::vector<std::vector<Node<W>>>::iterator &rhs, const typename std::vector<std::vector<Node<W>>>::iterator &rhs3, const typename std::vector<std::vector<Node<W>>>::iterator &rhs4, std::vector<T> *_id_to_node_, bool const* _frozen_, std::vector<std::vector<Node<W>>> *_reverse_, std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>> *_index_, const typename std::vector<Node<W>>::iterator &rhs2)
         : _it_ ( std::move(rhs) )                       // Member-wise move phase.
         , _it2_ ( std::move(rhs2) )
         , _last_it_ ( std::move(rhs3) )
+        , _first_it_ ( std::move(rhs4) )
         , _id_to_node_ptr_ ( std::move(_id_to_node_) )
+        , _frozen_ptr_ ( std::move(_frozen_) )
+        , _reverse_ptr_ ( std::move(_reverse_) )
+        , _index_ptr_ ( std::move(_index_) )
     {
         _id_to_node_ = nullptr;                         // Reset phase.
+        _frozen_ = nullptr;
+        _reverse_ = nullptr;
+        _index_ = nullptr;
     }
 
     template<typename T, typename W>
@@ -150,14 +187,14 @@ namespace graph
     template<typename T, typename W>
     typename undirected_graph<T, W>::edge_iterator& undirected_graph<T, W>::edge_iterator::operator++()
     {
-        // If it is not last non-empty mapping, but last element in current mapping, then goto next mapping.
-        if(_it2_ == _it_->second.end() - 1 && _it_ != _last_it_)
+        // If it is not last non-empty list, but last element in current list, then goto next list.
+        if(_it2_ == _it_->end() - 1 && _it_ != _last_it_)
         {
             ++_it_;
-            while(_it_->second.empty())
+            while(_it_->empty())
                 ++_it_;
 
-            _it2_ = _it_->second.begin();
+            _it2_ = _it_->begin();
         }
         else
             ++_it2_;
@@ -170,14 +207,14 @@ namespace graph
     {
         edge_iterator old = *this;
 
-        // If it is not last non-empty mapping, but last element in current mapping, then goto next mapping.
-        if(_it2_ == _it_->second.end() - 1 && _it_ != _last_it_)
+        // If it is not last non-empty list, but last element in current list, then goto next list.
+        if(_it2_ == _it_->end() - 1 && _it_ != _last_it_)
         {
             ++_it_;
-            while(_it_->second.empty())
+            while(_it_->empty())
                 ++_it_;
 
-            _it2_ = _it_->second.begin();
+            _it2_ = _it_->begin();
         }
         else
             ++_it2_;
@@ -188,18 +225,48 @@ namespace graph
     template<typename T, typename W>
     std::pair<const T&, const T&> undirected_graph<T, W>::edge_iterator::operator*() const
     {
-        return std::pair<T&, T&>( _id_to_node_ptr_->at(_it_->first), _id_to_node_ptr_->at(_it2_->vertex) );
+        return std::pair<T&, T&>( (*_id_to_node_ptr_)[_it_ - _first_it_], (*_id_to_node_ptr_)[_it2_->vertex] );
     }
 
     template<typename T, typename W>
     std::pair<const T*, const T*> undirected_graph<T, W>::edge_iterator::operator->() const
     {
-        return std::pair<T*, T*>( &(_id_to_node_ptr_->at(_it_->first)), &(_id_to_node_ptr_->at(_it2_->vertex)) );
+        return std::pair<T*, T*>( &((*_id_to_node_ptr_)[_it_ - _first_it_]), &((*_id_to_node_ptr_)[_it2_->vertex]) );
     }
 
     template<typename T, typename W>
     void undirected_graph<T, W>::edge_iterator::setWeight(W weight)
     {
+        // The CSR snapshot of a frozen graph must stay in sync with the adjacency list.
+        if(*_frozen_ptr_)
+            return;
+
+        unsigned int source = _it_ - _first_it_;
+
+        // The neighbour index of the source stores the weight too.
+        typename std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>>::iterator index = _index_ptr_->find(source);
+        if(index != _index_ptr_->end())
+        {
+            std::pair<typename std::unordered_multimap<unsigned int, W>::iterator, typename std::unordered_multimap<unsigned int, W>::iterator> range = index->second.equal_range(_it2_->vertex);
+            for(typename std::unordered_multimap<unsigned int, W>::iterator it = range.first; it != range.second; ++it)
+            {
+                if(it->second == _it2_->weight)
+                {
+                    it->second = weight;
+                    break;
+                }
+            }
+        }
+
+        // The matching in-edge of a directed graph carries the same weight.
+        if(_reverse_ptr_ != nullptr)
+        {
+            std::vector<Node<W>> &in_list = (*_reverse_ptr_)[_it2_->vertex];
+            typename std::vector<Node<W>>::iterator in_it = std::find(in_list.begin(), in_list.end(), Node<W>{source, _it2_->weight});
+            if(in_it != in_list.end())
+                in_it->weight = weight;
+        }
+
         _it2_->weight = weight;
     }
 
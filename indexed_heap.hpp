@@ -0,0 +1,172 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+namespace graph
+{
+    // Min-heap of ids in [0, capacity) ordered by a key, stored as a D-ary tree.
+    // Every id knows its position in the heap, so the key of a queued id can be decreased in O(log_D n).
+    template<typename Key, unsigned int D = 4>
+    class indexed_heap
+    {
+        private:
+            std::vector<unsigned int> _heap_;           // Ids in heap order.
+            std::vector<Key> _key_;                     // (id - key) mapping, valid while the id is queued.
+            std::vector<std::size_t> _position_;        // (id - position in _heap_) mapping, npos() if the id is not queued.
+
+            static std::size_t npos()
+            {
+                return std::numeric_limits<std::size_t>::max();
+            }
+
+            // Moves the id at position i towards the root until its parent has a smaller or equal key.
+            void siftUp(std::size_t i)
+            {
+                unsigned int id = _heap_[i];
+                while(i > 0)
+                {
+                    std::size_t parent = (i - 1) / D;
+                    if(!(_key_[id] < _key_[_heap_[parent]]))
+                        break;
+                    _heap_[i] = _heap_[parent];
+                    _position_[_heap_[i]] = i;
+                    i = parent;
+                }
+                _heap_[i] = id;
+                _position_[id] = i;
+            }
+
+            // Moves the id at position i towards the leaves until all its children have greater or equal keys.
+            void siftDown(std::size_t i)
+            {
+                unsigned int id = _heap_[i];
+                std::size_t n = _heap_.size();
+                while(true)
+                {
+                    std::size_t first = D * i + 1;
+                    if(first >= n)
+                        break;
+
+                    std::size_t last = first + D < n ? first + D : n;
+                    std::size_t best = first;
+                    for(std::size_t child = first + 1; child < last; ++child)
+                        if(_key_[_heap_[child]] < _key_[_heap_[best]])
+                            best = child;
+
+                    if(!(_key_[_heap_[best]] < _key_[id]))
+                        break;
+                    _heap_[i] = _heap_[best];
+                    _position_[_heap_[i]] = i;
+                    i = best;
+                }
+                _heap_[i] = id;
+                _position_[id] = i;
+            }
+
+        public:
+            // Allows ids in [0, n) to be queued. Never shrinks.
+            void reserve(std::size_t n)
+            {
+                if(_position_.size() < n)
+                {
+                    _key_.resize(n);
+                    _position_.resize(n, npos());
+                }
+            }
+
+            bool empty() const
+            {
+                return _heap_.empty();
+            }
+
+            std::size_t size() const
+            {
+                return _heap_.size();
+            }
+
+            bool contains(unsigned int id) const
+            {
+                return _position_[id] != npos();
+            }
+
+            unsigned int top() const
+            {
+                return _heap_.front();
+            }
+
+            const Key& topKey() const
+            {
+                return _key_[_heap_.front()];
+            }
+
+            const Key& key(unsigned int id) const
+            {
+                return _key_[id];
+            }
+
+            // The id must not be queued.
+            void push(unsigned int id, const Key &key)
+            {
+                _key_[id] = key;
+                _heap_.push_back(id);
+                siftUp(_heap_.size() - 1);
+            }
+
+            // The id must be queued, and the new key must not be greater than the current one.
+            void decreaseKey(unsigned int id, const Key &key)
+            {
+                _key_[id] = key;
+                siftUp(_position_[id]);
+            }
+
+            // Queues the id, or lowers its key if it is queued with a greater one.
+            void pushOrDecrease(unsigned int id, const Key &key)
+            {
+                if(!contains(id))
+                    push(id, key);
+                else if(key < _key_[id])
+                    decreaseKey(id, key);
+            }
+
+            // The id must be queued. Moves it up or down to match the new key.
+            void changeKey(unsigned int id, const Key &key)
+            {
+                bool smaller = key < _key_[id];
+                _key_[id] = key;
+                if(smaller)
+                    siftUp(_position_[id]);
+                else
+                    siftDown(_position_[id]);
+            }
+
+            // Removes and returns the id with the smallest key.
+            unsigned int pop()
+            {
+                unsigned int id = _heap_.front();
+                _position_[id] = npos();
+
+                unsigned int last = _heap_.back();
+                _heap_.pop_back();
+                if(!_heap_.empty())
+                {
+                    _heap_.front() = last;
+                    _position_[last] = 0;
+                    siftDown(0);
+                }
+                return id;
+            }
+
+            // Empties the heap in O(size) time, keeping the capacity.
+            void clear()
+            {
+                for(unsigned int id : _heap_)
+                    _position_[id] = npos();
+                _heap_.clear();
+            }
+    };
+}
+
+#endif
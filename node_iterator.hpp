@@ -11,11 +11,12 @@ namespace graph
         friend class undirected_graph<T, W>;
 
         private:
-            typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator _it_;
-            std::unordered_map<unsigned int, T> *_id_to_node_ptr_;
+            unsigned int _it_;                                  // Id of the current node.
+            std::vector<bool> const* _alive_ptr_;               // Used to skip the ids of removed nodes.
+            std::vector<T> *_id_to_node_ptr_;
             std::unordered_map<T, unsigned int> *_node_to_id_ptr_;
 
-            node_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator &, std::unordered_map<unsigned int, T> *, std::unordered_map<T, unsigned int> *);
+            node_iterator(unsigned int, std::vector<bool> const*, std::vector<T> *, std::unordered_map<T, unsigned int> *);
 
         public:
             /*
@@ -75,6 +76,7 @@ namespace graph
     template<typename T, typename W>
     undirected_graph<T, W>::node_iterator::node_iterator(const node_iterator &rhs)
         : _it_ ( rhs._it_ )
+        , _alive_ptr_ ( rhs._alive_ptr_ )
         , _id_to_node_ptr_ ( rhs._id_to_node_ptr_ )
         , _node_to_id_ptr_ ( rhs._node_to_id_ptr_ )
     {
@@ -84,6 +86,7 @@ namespace graph
     typename undirected_graph<T, W>::node_iterator& undirected_graph<T, W>::node_iterator::operator=(const node_iterator &rhs)
     {
         _it_ = rhs._it_;
+        _alive_ptr_ = rhs._alive_ptr_;
         _id_to_node_ptr_ = rhs._id_to_node_ptr_;
         _node_to_id_ptr_ = rhs._node_to_id_ptr_;
         return *this;
@@ -92,10 +95,12 @@ namespace graph
     template<typename T, typename W>
     undirected_graph<T, W>::node_iterator::node_iterator(node_iterator &&rhs) noexcept
         : _it_ ( std::move(rhs._it_) )                          // Member-wise move phase.
+        , _alive_ptr_ ( std::move(rhs._alive_ptr_) )
         , _id_to_node_ptr_ ( std::move(rhs._id_to_node_ptr_) )
         , _node_to_id_ptr_ ( std::move(rhs._node_to_id_ptr_) )
     {
-        rhs._id_to_node_ptr_ = nullptr;                         // Reset phase.
+        rhs._alive_ptr_ = nullptr;                              // Reset phase.
+        rhs._id_to_node_ptr_ = nullptr;
         rhs._node_to_id_ptr_ = nullptr;
     }
 
@@ -106,10 +111,12 @@ namespace graph
         
         // Member-wise move phase.
         _it_ = std::move(rhs._it_);
+        _alive_ptr_ = std::move(rhs._alive_ptr_);
         _id_to_node_ptr_ = std::move(rhs._id_to_node_ptr_);
         _node_to_id_ptr_ = std::move(rhs._node_to_id_ptr_);
         
         // Reset phase.
+        rhs._alive_ptr_ = nullptr;
         rhs._id_to_node_ptr_ = nullptr;
         rhs._node_to_id_ptr_ = nullptr;
 
@@ -118,13 +125,19 @@ namespace graph
 
     // Private constructor. Only move version is sufficienct.
     template<typename T, typename W>
-    undirected_graph<T, W>::node_iterator::node_iterator(const typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator &rhs, std::unordered_map<unsigned int, T> *_id_to_node_, std::unordered_map<T, unsigned int> *_node_to_id_)
-        : _it_ ( std::move(rhs) )                               // Member-wise move phase.
+    undirected_graph<T, W>::node_iterator::node_iterator(unsigned int rhs, std::vector<bool> const* _alive_, std::vector<T> *_id_to_node_, std::unordered_map<T, unsigned int> *_node_to_id_)
+        : _it_ ( rhs )                                          // Member-wise move phase.
+        , _alive_ptr_ ( std::move(_alive_) )
         , _id_to_node_ptr_ ( std::move(_id_to_node_) )
         , _node_to_id_ptr_ ( std::move(_node_to_id_) )
     {
-        _id_to_node_ = nullptr;                         // Reset phase.
+        _alive_ = nullptr;                              // Reset phase.
+        _id_to_node_ = nullptr;
         _node_to_id_ = nullptr;
+
+        // Skip the sentinel id 0 and the ids of removed nodes.
+        while(_it_ < _alive_ptr_->size() && !(*_alive_ptr_)[_it_])
+            ++_it_;
     }
 
     template<typename T, typename W>
@@ -142,7 +155,9 @@ namespace graph
     template<typename T, typename W>
     typename undirected_graph<T, W>::node_iterator& undirected_graph<T, W>::node_iterator::operator++()
     {
-        ++_it_;
+        do
+            ++_it_;
+        while(_it_ < _alive_ptr_->size() && !(*_alive_ptr_)[_it_]);
         return *this;
     }
 
@@ -150,20 +165,20 @@ namespace graph
     typename undirected_graph<T, W>::node_iterator undirected_graph<T, W>::node_iterator::operator++(int)
     {
         node_iterator old = *this;
-        ++_it_;
+        ++(*this);
         return old;
     }
 
     template<typename T, typename W>
     const T& undirected_graph<T, W>::node_iterator::operator*() const
     {
-        return _id_to_node_ptr_->at(_it_->first);
+        return (*_id_to_node_ptr_)[_it_];
     }
 
     template<typename T, typename W>
     const T* undirected_graph<T, W>::node_iterator::operator->() const
     {
-        return &(_id_to_node_ptr_->at(_it_->first));
+        return &((*_id_to_node_ptr_)[_it_]);
     }
 
     template<typename T, typename W>
@@ -172,10 +187,10 @@ namespace graph
         // Rename this node only if another node with same name doesn't exist.
         if(_node_to_id_ptr_->find(node) == _node_to_id_ptr_->end())
         {
-            unsigned int id = _it_->first;
-            _node_to_id_ptr_->erase(_id_to_node_ptr_->at(id));  // Removing the old entry in _node_to_id_.
+            unsigned int id = _it_;
+            _node_to_id_ptr_->erase((*_id_to_node_ptr_)[id]);   // Removing the old entry in _node_to_id_.
             _node_to_id_ptr_->insert({node, id});               // Adding the new entry in _node_to_id_.
-            _id_to_node_ptr_->at(id) = node;                    // Changing the node value in _id_to_node_.
+            (*_id_to_node_ptr_)[id] = node;                     // Changing the node value in _id_to_node_.
         }
     }
 }
@@ -0,0 +1,206 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <unordered_map>
+
+namespace graph
+{
+    // Returns the number of worker threads to use when the caller asks for 0(i.e. "all the cores").
+    inline unsigned int defaultThreads()
+    {
+        unsigned int threads = std::thread::hardware_concurrency();
+        return threads > 0 ? threads : 1;
+    }
+
+    // Splits [0, n) into one contiguous block per thread and calls fn(thread, first, last) on each block concurrently.
+    // An exception thrown by any worker is rethrown in the calling thread after all the workers have finished.
+    template<typename Function>
+    void parallelFor(std::size_t n, unsigned int threads, Function fn)
+    {
+        if(threads == 0)
+            threads = defaultThreads();
+        if(threads > n)
+            threads = n > 0 ? n : 1;
+
+        std::vector<std::thread> Workers;
+        std::vector<std::exception_ptr> Errors(threads);
+        std::size_t blockSize = (n + threads - 1) / threads;
+
+        for(unsigned int t = 0; t < threads; ++t)
+        {
+            std::size_t first = std::min(n, t * blockSize);
+            std::size_t last = std::min(n, first + blockSize);
+            Workers.emplace_back([&fn, &Errors, t, first, last]()
+            {
+                try
+                {
+                    fn(t, first, last);
+                }
+                catch(...)
+                {
+                    Errors[t] = std::current_exception();
+                }
+            });
+        }
+
+        for(std::thread &worker : Workers)
+            worker.join();
+
+        for(const std::exception_ptr &error : Errors)
+            if(error)
+                std::rethrow_exception(error);
+    }
+
+    // Reusable barrier for a fixed number of threads: wait() returns once all of them have called it.
+    class thread_barrier
+    {
+        private:
+            std::mutex _lock_;
+            std::condition_variable _released_;
+            unsigned int _threads_;
+            unsigned int _waiting_{0};
+            unsigned int _generation_{0};
+
+        public:
+            explicit thread_barrier(unsigned int threads) : _threads_ (threads)
+            {
+            }
+
+            void wait()
+            {
+                std::unique_lock<std::mutex> guard(_lock_);
+                unsigned int generation = _generation_;
+                if(++_waiting_ == _threads_)
+                {
+                    _waiting_ = 0;
+                    ++_generation_;
+                    _released_.notify_all();
+                }
+                else
+                    _released_.wait(guard, [this, generation]() { return generation != _generation_; });
+            }
+    };
+
+    // Processes a worklist in rounds. Each round calls fn(thread, round, id, Next) on every id of Work, and the ids pushed to the Next lists
+    // make up Work for the next round. Returns once a round pushes nothing, leaving Work empty.
+    // Large rounds are run by one team of threads, which hands the ids out in chunks of 64 as the threads ask for them(so a thread that drew
+    // expensive ids takes fewer). Small rounds are run by the calling thread alone, as waking the team would cost more than the round.
+    template<typename Function>
+    void parallelRounds(std::vector<unsigned int> &Work, unsigned int threads, Function fn)
+    {
+        if(threads == 0)
+            threads = defaultThreads();
+
+        const std::size_t grain = 64;
+        std::vector<std::vector<unsigned int>> Next(threads);
+        std::size_t round = 0;
+        while(!Work.empty())
+        {
+            if(Work.size() < grain * threads)
+            {
+                for(unsigned int id : Work)
+                    fn(0, round, id, Next[0]);
+                Work.swap(Next[0]);
+                Next[0].clear();
+                ++round;
+                continue;
+            }
+
+            std::atomic<std::size_t> next(0);
+            thread_barrier Barrier(threads);
+            parallelFor(threads, threads, [&](unsigned int t, std::size_t, std::size_t)
+            {
+                while(Work.size() >= grain * threads)
+                {
+                    for(std::size_t chunk = next.fetch_add(grain); chunk < Work.size(); chunk = next.fetch_add(grain))
+                        for(std::size_t i = chunk; i < std::min(Work.size(), chunk + grain); ++i)
+                            fn(t, round, Work[i], Next[t]);
+                    Barrier.wait();
+
+                    if(t == 0)
+                    {
+                        Work.clear();
+                        for(std::vector<unsigned int> &Local : Next)
+                        {
+                            Work.insert(Work.end(), Local.begin(), Local.end());
+                            Local.clear();
+                        }
+                        next.store(0, std::memory_order_relaxed);
+                        ++round;
+                    }
+                    Barrier.wait();
+                }
+            });
+        }
+    }
+
+    // Hash table of labels that can be filled by many threads at once. The table is split into shards, each guarded by its own mutex.
+    // A label is identified by a token: (shard index << 32 | index of the label within the shard).
+    // For every label, the smallest 'position' it was interned with is recorded, so the caller can number the labels deterministically.
+    template<typename T>
+    class label_table
+    {
+        private:
+            struct shard
+            {
+                std::mutex Lock;
+                std::unordered_map<T, std::uint32_t> Index;
+                std::vector<T> Labels;
+                std::vector<std::size_t> FirstSeen;
+            };
+
+            std::vector<shard> _shards_;
+
+        public:
+            explicit label_table(std::size_t shards = 64) : _shards_ (shards)
+            {
+            }
+
+            std::size_t shards() const
+            {
+                return _shards_.size();
+            }
+
+            // Given a label and the position it is seen at, returns its token.
+            std::uint64_t intern(const T &label, std::size_t position)
+            {
+                std::size_t s = std::hash<T>()(label) % _shards_.size();
+                shard &Shard = _shards_[s];
+                std::lock_guard<std::mutex> guard(Shard.Lock);
+
+                typename std::unordered_map<T, std::uint32_t>::iterator it = Shard.Index.find(label);
+                if(it != Shard.Index.end())
+                {
+                    if(position < Shard.FirstSeen[it->second])
+                        Shard.FirstSeen[it->second] = position;
+                    return (std::uint64_t(s) << 32) | it->second;
+                }
+
+                std::uint32_t local = Shard.Labels.size();
+                Shard.Index.insert(std::make_pair(label, local));
+                Shard.Labels.push_back(label);
+                Shard.FirstSeen.push_back(position);
+                return (std::uint64_t(s) << 32) | local;
+            }
+
+            // The accessors below must not be called while other threads are still interning.
+            const std::vector<T>& labels(std::size_t s) const
+            {
+                return _shards_[s].Labels;
+            }
+            const std::vector<std::size_t>& firstSeen(std::size_t s) const
+            {
+                return _shards_[s].FirstSeen;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include "indexed_heap.hpp"
+
+namespace graph
+{
+    // Id-indexed scratch arrays for single source searches.
+    // A search records every id it reaches in Touched, so preparing the workspace for the next search costs O(reached) instead of O(V).
+    template<typename D>
+    class search_workspace
+    {
+        public:
+            std::vector<D> Distance;            // (id - bestDistance) mapping, infinity() if not reached.
+            std::vector<unsigned int> Prev;     // (child - parent) mapping, 0 if there is no parent.
+            std::vector<unsigned int> Touched;  // Ids reached by the last search.
+            indexed_heap<D> Heap;               // Frontier of the search.
+
+            static D infinity()
+            {
+                return std::numeric_limits<D>::has_infinity ? std::numeric_limits<D>::infinity() : std::numeric_limits<D>::max();
+            }
+
+            // Resets the entries touched by the last search and makes room for ids in [0, n).
+            void prepare(std::size_t n)
+            {
+                for(unsigned int id : Touched)
+                {
+                    Distance[id] = infinity();
+                    Prev[id] = 0;
+                }
+                Touched.clear();
+                Heap.clear();
+
+                if(Distance.size() < n)
+                {
+                    Distance.resize(n, infinity());
+                    Prev.resize(n, 0);
+                    Heap.reserve(n);
+                }
+            }
+
+            // Records a better distance and parent for the id.
+            void relax(unsigned int id, D distance, unsigned int parent)
+            {
+                if(Distance[id] == infinity())
+                    Touched.push_back(id);
+                Distance[id] = distance;
+                Prev[id] = parent;
+            }
+    };
+
+    // Returns the calling thread's workspace number 'slot'(a search that runs two frontiers at once uses two slots).
+    // Workspaces are kept for the lifetime of the thread, so repeated queries do not allocate.
+    template<typename D>
+    search_workspace<D>& threadWorkspace(unsigned int slot = 0)
+    {
+        static thread_local search_workspace<D> Workspaces[2];
+        return Workspaces[slot];
+    }
+}
+
+#endif
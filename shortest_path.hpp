@@ -13,15 +13,36 @@ namespace graph
             return -1;
 
 
-        // Use Bellman-Ford for negative weighted graphs, Bidirectional Search for unweighted graphs, Dijkstra for others. 
+        unsigned int s = this->_node_to_id_.at(start);
+        unsigned int e = this->_node_to_id_.at(end);
+
+        // Use Bellman-Ford for negative weighted graphs, Bidirectional Search for unweighted graphs, Bidirectional Dijkstra for others.
         if(isNegWeighted)
-            return std::get<0>(bellmanFord(this->_node_to_id_.at(start)))[this->_node_to_id_.at(end)];
+        {
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            bellmanFord(Workspace, s);
+            return distanceTo(Workspace, e);
+        }
         else
         {
             if(isWeighted)
-                return std::get<0>(Dijkstra(this->_node_to_id_.at(start), this->_node_to_id_.at(end)))[this->_node_to_id_.at(end)];
+            {
+                search_workspace<distance_type> &Forward = threadWorkspace<distance_type>(0);
+                search_workspace<distance_type> &Backward = threadWorkspace<distance_type>(1);
+                unsigned int meet = bidirectionalDijkstra(Forward, Backward, s, e);
+                if(meet == 0)
+                    return std::numeric_limits<double>::infinity();
+                return distanceTo(Forward, meet) + distanceTo(Backward, meet);
+            }
             else
-                return std::get<0>(bidirectionalSearch(this->_node_to_id_.at(start), this->_node_to_id_.at(end)));
+            {
+                search_workspace<double> &Forward = threadWorkspace<double>(0);
+                search_workspace<double> &Backward = threadWorkspace<double>(1);
+                unsigned int meet = bidirectionalSearch(Forward, Backward, s, e);
+                if(meet == 0)
+                    return std::numeric_limits<double>::infinity();
+                return distanceTo(Forward, meet) + distanceTo(Backward, meet);
+            }
         }
     }
 
@@ -35,473 +56,1382 @@ namespace graph
 
         unsigned int s = this->_node_to_id_.at(start);
         unsigned int e = this->_node_to_id_.at(end);
-        std::unordered_map<unsigned int, double> Distance;
-        std::unordered_map<unsigned int, unsigned int> Prev;
 
-        // Use Bellman-Ford for negative weighted graphs, Bidirectional Search for unweighted graphs, Dijkstra for others.
+        // Use Bellman-Ford for negative weighted graphs, Bidirectional Search for unweighted graphs, Bidirectional Dijkstra for others.
         if(isNegWeighted)
-            std::tie(Distance, Prev) = bellmanFord(s);
+        {
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            bellmanFord(Workspace, s);
+            return pathTo(Workspace, s, e);
+        }
         else
         {
             if(isWeighted)
-                std::tie(Distance, Prev) = Dijkstra(s, e);
+            {
+                search_workspace<distance_type> &Forward = threadWorkspace<distance_type>(0);
+                search_workspace<distance_type> &Backward = threadWorkspace<distance_type>(1);
+                unsigned int meet = bidirectionalDijkstra(Forward, Backward, s, e);
+                return pathThrough(Forward, Backward, s, e, meet);
+            }
             else
-                return std::get<1>(bidirectionalSearch(s, e));
+            {
+                search_workspace<double> &Forward = threadWorkspace<double>(0);
+                search_workspace<double> &Backward = threadWorkspace<double>(1);
+                unsigned int meet = bidirectionalSearch(Forward, Backward, s, e);
+                return pathThrough(Forward, Backward, s, e, meet);
+            }
         }
+    }
 
-        // If the vertex is unreachable || is a part of negative weight cycle, return empty path.
-        std::vector<T> Path;
-        if(Distance[e] == std::numeric_limits<double>::infinity() || Distance[e] == std::numeric_limits<double>::infinity() * -1)
-            return Path;
+    template<typename T, typename W>
+    template<typename Heuristic>
+    double undirected_graph<T, W>::shortestDistance(T start, T end, Heuristic h) const
+    {
+        // If any of the vertex is invalid, return -1.
+        if(this->_node_to_id_.find(start) == this->_node_to_id_.end() || this->_node_to_id_.find(end) == this->_node_to_id_.end())
+            return -1;
 
-        // Reconstructing the path.
-        for(unsigned int curr = e; ; curr = Prev.at(curr))
-        {
-            Path.push_back(this->_id_to_node_.at(curr));
-            if(curr == s) break;
-        }
-        std::reverse(Path.begin(), Path.end());
+        // A heuristic cannot guide a search over negative weights, fall back to Bellman-Ford.
+        if(isNegWeighted)
+            return shortestDistance(start, end);
 
-        return Path;
+
+        unsigned int s = this->_node_to_id_.at(start);
+        unsigned int e = this->_node_to_id_.at(end);
+
+        search_workspace<double> &Workspace = threadWorkspace<double>();
+        AStar(Workspace, s, e, h);
+        return distanceTo(Workspace, e);
     }
 
     template<typename T, typename W>
-    std::unordered_map<T, double> undirected_graph<T, W>::singleSourceShortestDistances(unsigned int start) const
+    template<typename Heuristic>
+    std::vector<T> undirected_graph<T, W>::shortestPath(T start, T end, Heuristic h) const
+    {
+        // If any of the vertex is invalid, return empty vector.
+        if(this->_node_to_id_.find(start) == this->_node_to_id_.end() || this->_node_to_id_.find(end) == this->_node_to_id_.end())
+            return std::vector<T>();
+
+        // A heuristic cannot guide a search over negative weights, fall back to Bellman-Ford.
+        if(isNegWeighted)
+            return shortestPath(start, end);
+
+
+        unsigned int s = this->_node_to_id_.at(start);
+        unsigned int e = this->_node_to_id_.at(end);
+
+        search_workspace<double> &Workspace = threadWorkspace<double>();
+        AStar(Workspace, s, e, h);
+        return pathTo(Workspace, s, e);
+    }
+
+    template<typename T, typename W>
+    std::unordered_map<T, double> undirected_graph<T, W>::singleSourceShortestDistances(T start) const
     {
         // If the vertex is invalid, return empty map.
         if(this->_node_to_id_.find(start) == this->_node_to_id_.end())
             return std::unordered_map<T, double>();
 
 
-        std::unordered_map<unsigned int, double> Distance;
-        std::unordered_map<T, double> DistanceFinal;
+        unsigned int s = this->_node_to_id_.at(start);
+
         // Use Bellman-Ford for negative weighted graphs, Breadth First Search for unweighted graphs, Dijkstra for others. 
         if(isNegWeighted)
-            Distance = std::get<0>(bellmanFord(this->_node_to_id_.at(start)));
+        {
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            bellmanFord(Workspace, s);
+            return distancesFrom(Workspace);
+        }
         else
         {
             if(isWeighted)
-                Distance = std::get<0>(Dijkstra(this->_node_to_id_.at(start)));
+            {
+                search_workspace<distance_type> &Workspace = threadWorkspace<distance_type>();
+                Dijkstra(Workspace, s);
+                return distancesFrom(Workspace);
+            }
             else
-                Distance = std::get<0>(breadthFirstSearch(this->_node_to_id_.at(start)));
+            {
+                search_workspace<double> &Workspace = threadWorkspace<double>();
+                breadthFirstSearch(Workspace, s, 0);
+                return distancesFrom(Workspace);
+            }
         }
-
-        // Forming the Distance map with the actual node names.
-        for(const std::pair<unsigned int, double> &pair : Distance)
-            DistanceFinal[this->_id_to_node_.at(pair.first)] = pair.second;
-
-        return DistanceFinal;
     }
 
     template<typename T, typename W>
-    std::unordered_map<T, std::vector<T>> undirected_graph<T, W>::singleSourceShortestPaths(unsigned int start) const
+    std::unordered_map<T, double> undirected_graph<T, W>::singleSourceShortestDistances(T start, double delta, unsigned int threads) const
     {
         // If the vertex is invalid, return empty map.
         if(this->_node_to_id_.find(start) == this->_node_to_id_.end())
-            return std::unordered_map<T, std::vector<T>>();
-
-
-        unsigned int s = this->_node_to_id_.at(start);
-        std::unordered_map<T, std::vector<T>> Paths;
-        std::unordered_map<unsigned int, double> Distance;
-        std::unordered_map<unsigned int, unsigned int> Prev;
+            return std::unordered_map<T, double>();
 
-        // Use Bellman-Ford for negative weighted graphs, Breadth First Search for unweighted graphs, Dijkstra for others.
+        // Delta-stepping needs non-negative weights, use Bellman-Ford for negative weighted graphs.
         if(isNegWeighted)
-            std::tie(Distance, Prev) = bellmanFord(s);
-        else
         {
-            if(isWeighted)
-                std::tie(Distance, Prev) = Dijkstra(s);
-            else
-                std::tie(Distance, Prev) = breadthFirstSearch(s);
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            bellmanFord(Workspace, this->_node_to_id_.at(start));
+            return distancesFrom(Workspace);
         }
 
-        // Forming the paths for all the vertices.
-        for(const std::pair<unsigned int, T> &vertex : this->_id_to_node_)
+
+        unsigned int s = this->_node_to_id_.at(start);
+        if(threads == 0)
+            threads = defaultThreads();
+
+        // Unit weights need no buckets, the parallel BFS finds the same distances.
+        if(!isWeighted)
         {
-            // If the vertex is unreachable || is a part of negative weight cycle, return empty path.
-            if(Distance[vertex.first] == std::numeric_limits<double>::infinity() || Distance[vertex.first] == std::numeric_limits<double>::infinity() * -1)
-            {
-                Paths[vertex.second] = std::vector<T>();
-                continue;
-            }
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            breadthFirstSearch(Workspace, s, threads);
+            return distancesFrom(Workspace);
+        }
 
-            // Reconstructing the path.
-            for(unsigned int curr = vertex.first; ; curr = Prev.at(curr))
+        // Default bucket width: (largest weight / average degree), so a bucket holds about one hop of work per vertex.
+        // A given width is kept above (largest weight / number of vertices), so the circular array of buckets(largest weight / width) stays O(V).
+        double maxWeight = 0;
+        std::size_t edges = 0;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            for(const Node<W> &node : this->adjacent(id))
             {
-                Paths[vertex.second].push_back(this->_id_to_node_.at(curr));
-                if(curr == s) break;
+                maxWeight = std::max(maxWeight, static_cast<double>(node.weight));
+                ++edges;
             }
-            std::reverse(Paths[vertex.second].begin(), Paths[vertex.second].end());
+        if(!(delta > 0))
+        {
+            double degree = static_cast<double>(edges) / std::max<std::size_t>(this->_node_to_id_.size(), 1);
+            delta = maxWeight / std::max(degree, 1.0);
         }
+        delta = std::max(delta, maxWeight / (this->_node_to_id_.size() + 1));
+        if(!(delta > 0))
+            delta = 1;
+
+        std::vector<std::atomic<double>> Distance(this->_id_);
+        for(std::atomic<double> &distance : Distance)
+            distance.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+        Distance[s].store(0, std::memory_order_relaxed);
+        deltaStepping(Distance, s, delta, threads);
 
-        return Paths;
+        // Forming the Distance map with the actual node names.
+        std::unordered_map<T, double> DistanceFinal;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id))
+                DistanceFinal[this->_id_to_node_[id]] = Distance[id].load(std::memory_order_relaxed);
+
+        return DistanceFinal;
     }
 
     template<typename T, typename W>
     std::unordered_map<T, std::unordered_map<T, double>> undirected_graph<T, W>::allPairsShortestDistances() const
     {
-        std::unordered_map<unsigned int, std::unordered_map<unsigned int, double>> Distance;
         std::unordered_map<T, std::unordered_map<T, double>> DistanceFinal;
 
-        Distance = std::get<0>(floydWarshall());
-        for(const std::pair<unsigned int, std::unordered_map<unsigned int, double>> &edge : Distance)
-            for(const std::pair<unsigned int, double> &edge2 : edge.second)
-                DistanceFinal[this->_id_to_node_.at(edge.first)][this->_id_to_node_.at(edge2.first)] =  edge2.second;
+        // Ids of all the vertices in the graph.
+        std::vector<unsigned int> Ids;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id))
+                Ids.push_back(id);
+
+        dense_matrix<double> Distance;
+        dense_matrix<std::uint32_t> Next;
+        allPairsSearch(Ids, Distance, Next);
+
+        for(std::size_t i = 0; i < Ids.size(); ++i)
+        {
+            std::unordered_map<T, double> &Row = DistanceFinal[this->_id_to_node_[Ids[i]]];
+            Row.reserve(Ids.size());
+            for(std::size_t j = 0; j < Ids.size(); ++j)
+                Row[this->_id_to_node_[Ids[j]]] = Distance[i][j];
+        }
 
         return DistanceFinal;
     }
 
     template<typename T, typename W>
-    std::unordered_map<T, std::unordered_map<T, std::vector<T>>> undirected_graph<T, W>::allPairsShortestPaths() const
+    std::unordered_map<T, double> undirected_graph<T, W>::eccentricity(unsigned int threads) const
     {
-        std::unordered_map<unsigned int, std::unordered_map<unsigned int, unsigned int>> Next;
-        std::unordered_map<unsigned int, std::unordered_map<unsigned int, double>> Distance;
-        std::unordered_map<T, std::unordered_map<T, std::vector<T>>> Paths;
+        // Distances are unbounded below on negative weighted graphs, return empty map.
+        std::unordered_map<T, double> Eccentricity;
+        if(isNegWeighted)
+            return Eccentricity;
+
+        std::vector<unsigned int> Ids;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id))
+                Ids.push_back(id);
+
+        std::vector<double> Farthest;
+        std::vector<double> Total;
+        std::vector<std::size_t> Reached;
+        distanceSummary(Ids, Farthest, Total, Reached, threads);
 
-        std::tie(Distance, Next) = floydWarshall();
+        for(std::size_t r = 0; r < Ids.size(); ++r)
+            Eccentricity[this->_id_to_node_[Ids[r]]] = Farthest[r];
 
-        // For each pair of vertices.
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edge_list : this->_ADJACENCY_LIST_)
+        return Eccentricity;
+    }
+
+    template<typename T, typename W>
+    std::unordered_map<T, double> undirected_graph<T, W>::closenessCentrality(unsigned int threads) const
+    {
+        // Distances are unbounded below on negative weighted graphs, return empty map.
+        std::unordered_map<T, double> Closeness;
+        if(isNegWeighted)
+            return Closeness;
+
+        std::vector<unsigned int> Ids;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id))
+                Ids.push_back(id);
+
+        std::vector<double> Farthest;
+        std::vector<double> Total;
+        std::vector<std::size_t> Reached;
+        distanceSummary(Ids, Farthest, Total, Reached, threads);
+
+        // Wasserman and Faust: (reached / total distance) scaled by the share of the other vertices that are reached.
+        for(std::size_t r = 0; r < Ids.size(); ++r)
         {
-            for(const std::pair<unsigned int, std::vector<Node<W>>> &edge_list2 : this->_ADJACENCY_LIST_)
+            double closeness = 0;
+            if(Total[r] > 0)
+                closeness = (Reached[r] / Total[r]) * (Reached[r] / static_cast<double>(Ids.size() - 1));
+            Closeness[this->_id_to_node_[Ids[r]]] = closeness;
+        }
+
+        return Closeness;
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::distanceSummary(const std::vector<unsigned int> &Ids, std::vector<double> &Farthest, std::vector<double> &Total, std::vector<std::size_t> &Reached, unsigned int threads) const
+    {
+        std::size_t V = Ids.size();
+        Farthest.assign(V, 0);
+        Total.assign(V, 0);
+        Reached.assign(V, 0);
+        if(threads == 0)
+            threads = defaultThreads();
+
+        // Unit weights: multi-source BFS over batches of sources. Every source belongs to one batch, so its entries have a single writer.
+        if(!isWeighted)
+        {
+            typedef source_bitsets<4> bitsets;
+            std::size_t batches = (V + bitsets::sources() - 1) / bitsets::sources();
+            parallelFor(batches, threads, [&](unsigned int, std::size_t first, std::size_t last)
             {
-                // If the distance is infinity, empty path.
-                if(Distance[edge_list.first][edge_list2.first] == std::numeric_limits<double>::infinity())
-                    Paths[this->_id_to_node_.at(edge_list.first)][this->_id_to_node_.at(edge_list2.first)] = std::vector<T>();
-                else
+                bitsets Bits;
+                for(std::size_t b = first; b < last; ++b)
                 {
-                    // Reconstruct the path.
-                    std::vector<T> &Path = Paths[this->_id_to_node_.at(edge_list.first)][this->_id_to_node_.at(edge_list2.first)];
-                    unsigned int at = edge_list.first;
-                    for(; at != edge_list2.first; at = Next[at][edge_list2.first])
+                    std::size_t base = b * bitsets::sources();
+                    multiSourceBFS(Bits, Ids, base, std::min(V, base + bitsets::sources()), [&](unsigned int, unsigned int, std::size_t level, const std::uint64_t *Sources)
                     {
-                        if(at == 0)
+                        if(level == 0)
+                            return;
+                        for(std::size_t l = 0; l < 4; ++l)
                         {
-                            Path.clear();
-                            break;
+                            for(std::uint64_t bits = Sources[l]; bits != 0; bits &= bits - 1)
+                            {
+                                std::size_t r = base + l * 64 + lowestBit(bits);
+                                Farthest[r] = level;
+                                Total[r] += level;
+                                Reached[r] += 1;
+                            }
                         }
-                        Path.push_back(this->_id_to_node_.at(at));
-                    }
-                    if(Next[at][edge_list2.first] == 0)
-                        Path.clear();
-                    else
-                        Path.push_back(this->_id_to_node_.at(edge_list2.first));
+                    });
                 }
-            }
+            });
+            return;
         }
 
-        return Paths;
+        parallelFor(V, threads, [&](unsigned int, std::size_t first, std::size_t last)
+        {
+            search_workspace<distance_type> &Workspace = threadWorkspace<distance_type>();
+            for(std::size_t r = first; r < last; ++r)
+            {
+                Dijkstra(Workspace, Ids[r]);
+                for(unsigned int id : Workspace.Touched)
+                {
+                    if(id == Ids[r])
+                        continue;
+                    double dist = distanceTo(Workspace, id);
+                    Farthest[r] = std::max(Farthest[r], dist);
+                    Total[r] += dist;
+                    Reached[r] += 1;
+                }
+            }
+        });
     }
 
-    struct minPairComp
-    { 
-        constexpr bool operator()(const std::pair<unsigned int, double> &a, const std::pair<unsigned int, double> &b) const noexcept
+    template<typename T, typename W>
+    void undirected_graph<T, W>::Dijkstra(search_workspace<distance_type> &Workspace, unsigned int start, unsigned int end) const
+    {
+        Workspace.prepare(this->_id_);
+        Workspace.relax(start, 0, 0);
+
+        // Pick the priority queue at compile time from the weight type.
+        DijkstraSearch(Workspace, start, end, std::is_integral<W>());
+    }
+
+    // Eager implementation of Dijkstra on an indexed heap: every vertex is queued at most once and its key is decreased in place.
+    // A vertex's distance is final once it is popped, so no explored set is needed.
+    template<typename T, typename W>
+    void undirected_graph<T, W>::DijkstraSearch(search_workspace<double> &Workspace, unsigned int start, unsigned int end, std::false_type) const
+    {
+        Workspace.Heap.reserve(this->_id_);
+        Workspace.Heap.push(start, 0);
+
+        while(!Workspace.Heap.empty())
         {
-            return a.second > b.second;
+            // Select the next best node to explore(best - min distance).
+            start = Workspace.Heap.pop();
+
+            // Early stopping condition (destination vertex is explored completely --> distance cannot be updated further).
+            if(start == end)
+                return;
+
+            for(const Node<W> &node : this->adjacent(start))
+            {
+                // If next better distance is found, update it.
+                double newDist = Workspace.Distance[start] + node.weight;
+                if(newDist < Workspace.Distance[node.vertex])
+                {
+                    Workspace.relax(node.vertex, newDist, start);
+                    Workspace.Heap.pushOrDecrease(node.vertex, newDist);
+                }
+            }
         }
-    };
+    }
 
-    // Lazy implementation of Dijkstra. We should use Indexed Priority Queue for Eager implementation.
+    // Integral weights: distances stay integral and only grow, so a monotone bucket queue can replace the heap.
     template<typename T, typename W>
-    std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>> undirected_graph<T, W>::Dijkstra(unsigned int start, unsigned int end) const
+    void undirected_graph<T, W>::DijkstraSearch(search_workspace<unsigned long long> &Workspace, unsigned int start, unsigned int end, std::true_type) const
     {
-        typedef std::pair<unsigned int, double> pair;
-
-        std::unordered_set<unsigned int> Explored;
-        std::priority_queue<pair, std::vector<pair>, minPairComp> Q;   // (vertex - distance) priority queue.
-        std::unordered_map<unsigned int, double> Distance;      // (vertex - bestDistance) mapping.
-        std::unordered_map<unsigned int, unsigned int> Prev;    // (child - parent) mapping.
-        double minDist = 0;
-        double newDist = 0;
+        // Each thread keeps its queues, so their buckets are allocated once.
+        static thread_local dial_queue<unsigned long long> Buckets;
+        static thread_local radix_heap<unsigned long long> Radix;
 
-        // Initialization phase.
-        for(const std::pair<unsigned int, T> &vertices : this->_id_to_node_)
-            Distance[vertices.first] = std::numeric_limits<double>::infinity();
+        // The largest weight is only known(and fixed) while the graph is frozen.
+        if(this->_frozen_ && this->_CSR_.MaxWeight >= 0 && static_cast<unsigned long long>(this->_CSR_.MaxWeight) <= _DIAL_MAX_WEIGHT_)
+        {
+            Buckets.reset(this->_CSR_.MaxWeight);
+            DijkstraSearch(Workspace, start, end, Buckets);
+        }
+        else
+        {
+            Radix.clear();
+            DijkstraSearch(Workspace, start, end, Radix);
+        }
+    }
 
-        Distance[start] = 0;
-        Q.push(pair(start, 0));
+    // Lazy Dijkstra over a monotone queue: a vertex is pushed again whenever its distance improves, and stale pairs are skipped.
+    template<typename T, typename W>
+    template<typename Queue>
+    void undirected_graph<T, W>::DijkstraSearch(search_workspace<unsigned long long> &Workspace, unsigned int start, unsigned int end, Queue &Q) const
+    {
+        typedef std::pair<unsigned long long, unsigned int> pair;
 
+        Q.push(start, 0);
         while(!Q.empty())
         {
             // Select the next best node to explore(best - min distance).
-            start = Q.top().first;
-            minDist = Q.top().second;
-            Q.pop();
-            
+            pair top = Q.pop();
+            start = top.second;
+
             // If the bestDistance found for the vertex is less than distance in current pair, then discard the pair.
-            if(Distance[start] < minDist)
+            if(Workspace.Distance[start] < top.first)
                 continue;
-            
-            for(const Node<W> &node : this->_ADJACENCY_LIST_.at(start))
+
+            // Early stopping condition (destination vertex is explored completely --> distance cannot be updated further).
+            if(start == end)
+                return;
+
+            for(const Node<W> &node : this->adjacent(start))
             {
-                // The best distance for a vertex cannot be updated, if the vertex is already completely explored(exploring --> exploring its neighbours).
-                if(Explored.find(node.vertex) == Explored.end())
+                // If next better distance is found, update it.
+                unsigned long long newDist = top.first + node.weight;
+                if(newDist < Workspace.Distance[node.vertex])
                 {
-                    // If next better distance is found, update it.
-                    newDist = Distance[start] + node.weight;
-                    if(newDist < Distance[node.vertex])
-                    {
-                        Distance[node.vertex] = newDist;
-                        Prev[node.vertex] = start;
-                        Q.push(pair(node.vertex, newDist));
-                    }
+                    Workspace.relax(node.vertex, newDist, start);
+                    Q.push(node.vertex, newDist);
                 }
             }
+        }
+    }
 
-            // Early stopping condition (destination vertex is explored completely --> distance cannot be updated further).
+    // Dijkstra on the heap keyed by (distance + estimate to the destination). Workspace.Distance keeps the exact distances.
+    // A vertex whose distance improves after it was popped is queued again, so the result is optimal for any admissible heuristic.
+    template<typename T, typename W>
+    template<typename Heuristic>
+    void undirected_graph<T, W>::AStar(search_workspace<double> &Workspace, unsigned int start, unsigned int end, Heuristic &h) const
+    {
+        Workspace.prepare(this->_id_);
+        Workspace.relax(start, 0, 0);
+        Workspace.Heap.push(start, static_cast<double>(h(this->_id_to_node_[start])));
+
+        while(!Workspace.Heap.empty())
+        {
+            // Select the next most promising node to explore(min distance + estimate).
+            start = Workspace.Heap.pop();
+
+            // Early stopping condition (no queued estimate can beat the destination's distance any more).
             if(start == end)
-                return std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>>(Distance, Prev);
+                return;
 
-            // After exploring the current vertex, add it to Explored set.
-            Explored.insert(start);
+            for(const Node<W> &node : this->adjacent(start))
+            {
+                // If next better distance is found, update it and (re)queue the vertex.
+                double newDist = Workspace.Distance[start] + node.weight;
+                if(newDist < Workspace.Distance[node.vertex])
+                {
+                    Workspace.relax(node.vertex, newDist, start);
+                    Workspace.Heap.pushOrDecrease(node.vertex, newDist + static_cast<double>(h(this->_id_to_node_[node.vertex])));
+                }
+            }
         }
-
-        return std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>>(Distance, Prev);
     }
 
+    // Delta-stepping: vertices are kept in buckets of width delta by tentative distance, and the smallest bucket is settled in phases.
+    // Light edges(weight <= delta) can put vertices back into the current bucket, so they are relaxed repeatedly until it stays empty.
+    // Heavy edges cannot, so they are relaxed once from every vertex the bucket settled. The vertices of a phase are relaxed by all the
+    // threads at once(distances are lowered with compare-and-swap). Thread 0 alone moves the improved vertices into their buckets between phases.
     template<typename T, typename W>
-    std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>> undirected_graph<T, W>::bellmanFord(unsigned int start) const
+    void undirected_graph<T, W>::deltaStepping(std::vector<std::atomic<double>> &Distance, unsigned int start, double delta, unsigned int threads) const
     {
-        std::unordered_map<unsigned int, double> Distance;
-        std::unordered_map<unsigned int, unsigned int> Prev;
-        double newDist = 0;
-        int V = this->_node_to_id_.size();
-        Distance[start] = 0;
-        
-        // Finding shortest paths ny relaxation V - 1 times.
-        for(int i = 1; i <= V - 1; ++i)
+        // Every queued vertex is within one maximal edge of the current bucket, so a circular array of buckets suffices.
+        double maxWeight = 0;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            for(const Node<W> &node : this->adjacent(id))
+                maxWeight = std::max(maxWeight, static_cast<double>(node.weight));
+        std::vector<std::vector<unsigned int>> Buckets(static_cast<std::size_t>(maxWeight / delta) + 2);
+
+        std::vector<unsigned int> Frontier;                         // Vertices relaxed by the current phase.
+        std::vector<unsigned int> Settled;                          // Vertices settled by the current bucket(their heavy edges are pending).
+        std::vector<std::vector<unsigned int>> Improved(threads);   // Vertices each thread lowered the distance of during the phase.
+        std::vector<std::size_t> Stamp(this->_id_, 0);              // Last phase/bucket that took the vertex, to drop duplicates.
+        std::atomic<std::size_t> next(0);
+        std::size_t current = 0;
+        std::size_t phase = 0;
+        std::size_t queued = 0;
+        bool heavy = false;
+        bool done = false;
+        thread_barrier Barrier(threads);
+
+        auto bucketOf = [&](unsigned int id)
         {
-            for(const std::pair<unsigned int, std::vector<Node<W>>> &edge_list : this->_ADJACENCY_LIST_)
+            return static_cast<std::size_t>(Distance[id].load(std::memory_order_relaxed) / delta);
+        };
+
+        // Serial step between phases: files the improved vertices into their buckets and picks the vertices of the next phase.
+        auto advance = [&]()
+        {
+            for(std::vector<unsigned int> &List : Improved)
             {
-                if(Distance.find(edge_list.first) == Distance.end())
-                    Distance[edge_list.first] = std::numeric_limits<double>::infinity();
-                
-                for(const Node<W> &node : edge_list.second)
+                for(unsigned int id : List)
                 {
-                    // If next better distance is found || if the distance is infinity, update it.
-                    newDist = Distance[edge_list.first] + node.weight;
-                    if(Distance.find(node.vertex) == Distance.end() || newDist < Distance[node.vertex])
-                    {
-                        Distance[node.vertex] = newDist;
-                        Prev[node.vertex] = edge_list.first;
-                    }
+                    Buckets[bucketOf(id) % Buckets.size()].push_back(id);
+                    ++queued;
                 }
+                List.clear();
             }
-        }
-        
-        // V - 1 iterations are necessary to detect all vertices which are part of negative cycle and also vertices that can be reached form the cycle.
-        for(int i = 1; i <= V - 1; ++i)
+
+            ++phase;
+            Frontier.clear();
+            next.store(0, std::memory_order_relaxed);
+
+            while(true)
+            {
+                // Take the entries of the current bucket that still belong to it.
+                std::vector<unsigned int> &Bucket = Buckets[current % Buckets.size()];
+                queued -= Bucket.size();
+                for(unsigned int id : Bucket)
+                {
+                    if(bucketOf(id) != current || Stamp[id] == phase)
+                        continue;
+                    Stamp[id] = phase;
+                    Frontier.push_back(id);
+                }
+                Bucket.clear();
+
+                if(!Frontier.empty())
+                {
+                    heavy = false;
+                    Settled.insert(Settled.end(), Frontier.begin(), Frontier.end());
+                    return;
+                }
+
+                // The bucket stays empty: relax the heavy edges of everything it settled(they lead to later buckets only).
+                if(!heavy && !Settled.empty())
+                {
+                    heavy = true;
+                    std::sort(Settled.begin(), Settled.end());
+                    Settled.erase(std::unique(Settled.begin(), Settled.end()), Settled.end());
+                    Frontier.swap(Settled);
+                    return;
+                }
+
+                // The bucket is done, move on to the next one.
+                if(queued == 0)
+                {
+                    done = true;
+                    return;
+                }
+                ++current;
+                heavy = false;
+            }
+        };
+
+        Frontier.push_back(start);
+        Settled.push_back(start);
+        Stamp[start] = phase;
+
+        parallelFor(threads, threads, [&](unsigned int t, std::size_t, std::size_t)
         {
-            for(const std::pair<unsigned int, std::vector<Node<W>>> &edge_list : this->_ADJACENCY_LIST_)
+            const std::size_t grain = 64;
+            while(true)
             {
-                for(const Node<W> &node : edge_list.second)
+                // Relax the outgoing light/heavy edges of the frontier, a grain of vertices at a time.
+                for(std::size_t first = next.fetch_add(grain); first < Frontier.size(); first = next.fetch_add(grain))
                 {
-                    if(Distance[edge_list.first] + node.weight < Distance[node.vertex])
-                        Distance[node.vertex] = std::numeric_limits<double>::infinity() * -1;
+                    std::size_t last = std::min(Frontier.size(), first + grain);
+                    for(std::size_t i = first; i < last; ++i)
+                    {
+                        unsigned int vertex = Frontier[i];
+                        double dist = Distance[vertex].load(std::memory_order_relaxed);
+                        for(const Node<W> &node : this->adjacent(vertex))
+                        {
+                            if((node.weight > delta) != heavy)
+                                continue;
+
+                            // If next better distance is found, update it.
+                            double newDist = dist + node.weight;
+                            double old = Distance[node.vertex].load(std::memory_order_relaxed);
+                            while(newDist < old && !Distance[node.vertex].compare_exchange_weak(old, newDist, std::memory_order_relaxed))
+                                ;
+                            if(newDist < old)
+                                Improved[t].push_back(node.vertex);
+                        }
+                    }
                 }
+
+                Barrier.wait();
+                if(t == 0)
+                    advance();
+                Barrier.wait();
+                if(done)
+                    return;
             }
-        }
+        });
+    }
 
-        return std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>>(Distance, Prev);
+    // Queue-based Bellman-Ford(SPFA): only vertices whose distance improved are scanned again, so it stops as soon as nothing changes.
+    // Length[v] is the number of edges on the path to v. A path of V edges repeats a vertex, i.e. it went around a negative cycle:
+    // such a vertex is not scanned any more(which breaks the cycle) and every vertex reachable from it is marked -inf by one traversal.
+    template<typename T, typename W>
+    void undirected_graph<T, W>::bellmanFord(search_workspace<double> &Workspace, unsigned int start) const
+    {
+        bellmanFord(Workspace, std::vector<unsigned int>(1, start));
     }
 
+    // With several sources, all of them start at distance 0(as if an extra vertex had a 0 weight edge to each).
     template<typename T, typename W>
-    std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>> undirected_graph<T, W>::breadthFirstSearch(unsigned int start) const
+    void undirected_graph<T, W>::bellmanFord(search_workspace<double> &Workspace, const std::vector<unsigned int> &starts) const
     {
-        std::unordered_set<unsigned int> Visited;
-        std::unordered_map<unsigned int, double> Distance;
-        std::unordered_map<unsigned int, unsigned int> Prev;
+        unsigned int V = this->_node_to_id_.size() + (starts.size() > 1);
+        std::vector<unsigned int> Length(this->_id_, 0);
+        std::vector<bool> Queued(this->_id_, false);
+        std::vector<unsigned int> Cycles;
         std::queue<unsigned int> Q;
 
-        for(const std::pair<unsigned int, T> &vertices : this->_id_to_node_)
-            Distance[vertices.first] = std::numeric_limits<double>::infinity();
-
-        Q.push(start);
-        Visited.insert(start);
-        Distance[start] = 0;
+        Workspace.prepare(this->_id_);
+        for(unsigned int start : starts)
+        {
+            Workspace.relax(start, 0, 0);
+            Q.push(start);
+            Queued[start] = true;
+        }
 
         while(!Q.empty())
         {
-            start = Q.front();
+            unsigned int vertex = Q.front();
             Q.pop();
+            Queued[vertex] = false;
+
+            if(Length[vertex] >= V)
+            {
+                Cycles.push_back(vertex);
+                continue;
+            }
 
-            for(const Node<W> &node : this->_ADJACENCY_LIST_.at(start))
+            for(const Node<W> &node : this->adjacent(vertex))
             {
-                if(Visited.find(node.vertex) == Visited.end())
+                // If next better distance is found, update it and queue the vertex(if it is not queued already).
+                double newDist = Workspace.Distance[vertex] + node.weight;
+                if(newDist < Workspace.Distance[node.vertex])
                 {
-                    Visited.insert(node.vertex);
-                    Distance[node.vertex] = Distance[start] + 1;
-                    Prev[node.vertex] = start;
-                    Q.push(node.vertex);
+                    Workspace.relax(node.vertex, newDist, vertex);
+                    Length[node.vertex] = Length[vertex] + 1;
+                    if(!Queued[node.vertex])
+                    {
+                        Q.push(node.vertex);
+                        Queued[node.vertex] = true;
+                    }
                 }
             }
         }
 
-        return std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>>(Distance, Prev);
+        // Mark the vertices that are part of a negative cycle or can be reached from one.
+        std::vector<unsigned int> Stack;
+        for(unsigned int vertex : Cycles)
+        {
+            if(Workspace.Distance[vertex] == std::numeric_limits<double>::infinity() * -1)
+                continue;
+            Workspace.relax(vertex, std::numeric_limits<double>::infinity() * -1, Workspace.Prev[vertex]);
+            Stack.push_back(vertex);
+        }
+        while(!Stack.empty())
+        {
+            unsigned int vertex = Stack.back();
+            Stack.pop_back();
+            for(const Node<W> &node : this->adjacent(vertex))
+            {
+                if(Workspace.Distance[node.vertex] != std::numeric_limits<double>::infinity() * -1)
+                {
+                    Workspace.relax(node.vertex, std::numeric_limits<double>::infinity() * -1, Workspace.Prev[node.vertex]);
+                    Stack.push_back(node.vertex);
+                }
+            }
+        }
     }
 
     template<typename T, typename W>
-    std::tuple<double, std::vector<T>> undirected_graph<T, W>::bidirectionalSearch(unsigned int start, unsigned int end) const
+    void undirected_graph<T, W>::breadthFirstSearch(search_workspace<double> &Workspace, unsigned int start, unsigned int threads) const
     {
-        typedef std::pair<unsigned int, double> pair;
+        bfs_frontier Frontier;
+        Workspace.prepare(this->_id_);
+        Frontier.reset(this->_id_);
+        breadthFirstSearch(Workspace, start, Frontier, threads);
+    }
 
-        std::queue<pair> s_Q;
-        std::queue<pair> e_Q;
-        std::unordered_map<unsigned int, double> s_Visited;
-        std::unordered_map<unsigned int, double> e_Visited;
-        std::unordered_map<unsigned int, unsigned int> s_Prev;
-        std::unordered_map<unsigned int, unsigned int> e_Prev;
-        s_Q.push(pair(start, 0));
-        e_Q.push(pair(end, 0));
-        s_Visited[start] = 0;
-        e_Visited[end] = 0;
+    template<typename T, typename W>
+    void undirected_graph<T, W>::breadthFirstSearch(search_workspace<double> &Workspace, unsigned int start, bfs_frontier &Frontier, unsigned int threads) const
+    {
+        if(Frontier.Visited.test(start))
+            return;
+        if(threads == 0)
+            threads = defaultThreads();
+
+        // Touched holds the levels one after another, the last one being the frontier.
+        std::size_t first = Workspace.Touched.size();
+        Workspace.relax(start, 0, 0);
+        Frontier.Visited.set(start);
+        if(Frontier.Unexplored != bfs_frontier::unknown())
+            Frontier.Unexplored -= this->inAdjacent(start).size();
+        Frontier.BottomUp = false;
+        Frontier.LastSize = 0;
+
+        while(first < Workspace.Touched.size())
+        {
+            std::size_t last = Workspace.Touched.size();
+
+            // Once a level is large enough to keep the threads busy, they take over the rest of the search.
+            if(threads > 1 && last - first >= _PARALLEL_BFS_THRESHOLD_)
+            {
+                parallelBreadthFirstSearch(Workspace, first, Frontier, threads);
+                return;
+            }
+
+            breadthFirstStep(Workspace, first, last, Frontier, false);
+            first = last;
+        }
+    }
+
+    // Same levels as breadthFirstStep, run by a team of threads that meet at a barrier between the phases of each level.
+    // Top-down, the threads take chunks of the frontier from a shared counter and claim every vertex they reach with an atomic
+    // fetch_or on the visited bitmap, so each vertex gets exactly one parent; what a thread claims goes to its own local frontier.
+    // Bottom-up, the threads take chunks of the visited bitmap's words instead, and a word is only written by the thread that took it.
+    // Thread 0 alone chooses the direction and appends the local frontiers to Touched, which becomes the next level.
+    template<typename T, typename W>
+    void undirected_graph<T, W>::parallelBreadthFirstSearch(search_workspace<double> &Workspace, std::size_t first, bfs_frontier &Frontier, unsigned int threads) const
+    {
+        std::vector<std::vector<unsigned int>> Local(threads);  // Vertices each thread reached during the level.
+        std::vector<std::size_t> Edges(threads, 0);             // Out-edges of the frontier, counted by each thread.
+        std::vector<std::size_t> Explored(threads, 0);          // In-edges of the vertices each thread reached.
+        std::atomic<std::size_t> next(0);
+        std::size_t last = Workspace.Touched.size();
+        bool counting = false;
+        thread_barrier Barrier(threads);
+
+        auto up = [this](unsigned int id) { return this->inAdjacent(id); };
 
-        // Loop should execute until both the queues are empty.
-        while(!s_Q.empty() || !e_Q.empty())
+        parallelFor(threads, threads, [&](unsigned int t, std::size_t, std::size_t)
         {
-            if (!s_Q.empty())
+            const std::size_t grain = 64;
+            while(first < last)
             {
-                unsigned int vertex = s_Q.front().first;
-                double dist = s_Q.front().second;
-                s_Q.pop();
+                std::size_t block = (last - first + threads - 1) / threads;
+                std::size_t from = std::min(last, first + t * block);
+                std::size_t to = std::min(last, from + block);
+                for(std::size_t i = from; i < to; ++i)
+                    Edges[t] += this->adjacent(Workspace.Touched[i]).size();
+                Barrier.wait();
+
+                if(t == 0)
+                {
+                    std::size_t frontierEdges = 0;
+                    for(std::size_t &edges : Edges)
+                    {
+                        frontierEdges += edges;
+                        edges = 0;
+                    }
+                    Frontier.choose(last - first, frontierEdges, this->_id_, [&]()
+                    {
+                        std::size_t unexplored = 0;
+                        for(unsigned int id = 1; id < this->_id_; ++id)
+                            if(!Frontier.Visited.test(id))
+                                unexplored += up(id).size();
+                        return unexplored;
+                    });
+                    if(Frontier.BottomUp)
+                        Frontier.Current.reset(this->_id_);
+                    counting = Frontier.Unexplored != bfs_frontier::unknown();
+                    next.store(0, std::memory_order_relaxed);
+                }
+                Barrier.wait();
 
-                // If this vertex is already visited from other end, this is the intersection point. Search can be stopped.
-                if(e_Visited.find(vertex) != e_Visited.end())
+                double level = Workspace.Distance[Workspace.Touched[first]] + 1;
+                if(!Frontier.BottomUp)
                 {
-                    // Constructing the path.
-                    std::vector<T> Path;
-                    Path.push_back(this->_id_to_node_.at(vertex));
-                    
-                    int i = vertex;
-                    while (i != start)
+                    for(std::size_t chunk = next.fetch_add(grain); first + chunk < last; chunk = next.fetch_add(grain))
                     {
-                        Path.push_back(this->_id_to_node_.at(s_Prev[i]));
-                        i = s_Prev[i];
+                        for(std::size_t i = first + chunk; i < std::min(last, first + chunk + grain); ++i)
+                        {
+                            unsigned int vertex = Workspace.Touched[i];
+                            for(const Node<W> &node : this->adjacent(vertex))
+                            {
+                                if(!Frontier.Visited.test(node.vertex) && Frontier.Visited.claim(node.vertex))
+                                {
+                                    Workspace.Distance[node.vertex] = level;
+                                    Workspace.Prev[node.vertex] = vertex;
+                                    Local[t].push_back(node.vertex);
+                                    if(counting)
+                                        Explored[t] += up(node.vertex).size();
+                                }
+                            }
+                        }
                     }
-                    reverse(Path.begin(), Path.end());
-                    
-                    i = vertex;
-                    while(i != end)
+                }
+                else
+                {
+                    for(std::size_t i = from; i < to; ++i)
+                        Frontier.Current.claim(Workspace.Touched[i]);
+                    Barrier.wait();
+
+                    for(std::size_t w = next.fetch_add(grain); w < Frontier.Visited.words(); w = next.fetch_add(grain))
                     {
-                        Path.push_back(this->_id_to_node_.at(e_Prev[i]));
-                        i = e_Prev[i];
+                        for(std::size_t word = w; word < std::min(Frontier.Visited.words(), w + grain); ++word)
+                        {
+                            for(std::uint64_t bits = ~Frontier.Visited.word(word); bits != 0; bits &= bits - 1)
+                            {
+                                unsigned int id = word * 64 + lowestBit(bits);
+                                for(const Node<W> &node : up(id))
+                                {
+                                    if(Frontier.Current.test(node.vertex))
+                                    {
+                                        Frontier.Visited.set(id);
+                                        Workspace.Distance[id] = level;
+                                        Workspace.Prev[id] = node.vertex;
+                                        Local[t].push_back(id);
+                                        if(counting)
+                                            Explored[t] += up(id).size();
+                                        break;
+                                    }
+                                }
+                            }
+                        }
                     }
-                    
-                    return std::tuple<double, std::vector<T>>(dist + e_Visited.at(vertex), Path);
                 }
+                Barrier.wait();
 
-                for (const Node<W> &node : this->_ADJACENCY_LIST_.at(vertex))
+                if(t == 0)
                 {
-                    if (s_Visited.find(node.vertex) == s_Visited.end())
+                    for(unsigned int u = 0; u < threads; ++u)
                     {
-                        s_Prev[node.vertex] = vertex;
-                        s_Q.push(pair(node.vertex, dist + 1));
-                        s_Visited[node.vertex] = dist + 1;
+                        Workspace.Touched.insert(Workspace.Touched.end(), Local[u].begin(), Local[u].end());
+                        Local[u].clear();
+                        if(counting)
+                            Frontier.Unexplored -= Explored[u];
+                        Explored[u] = 0;
                     }
+                    first = last;
+                    last = Workspace.Touched.size();
                 }
+                Barrier.wait();
             }
+        });
+    }
 
-            if (!e_Q.empty())
-            {
-                unsigned int vertex = e_Q.front().first;
-                double dist = e_Q.front().second;
-                e_Q.pop();
+    // MS-BFS(Then et al.): the BFS of every source of the batch advances in lock step, one level at a time. A vertex of the frontier
+    // hands the sources it is visited by to each neighbour, minus the sources that reached the neighbour already, so the sources
+    // share the scan of every edge instead of scanning it once each.
+    template<typename T, typename W>
+    template<std::size_t Lanes, typename Reach>
+    void undirected_graph<T, W>::multiSourceBFS(source_bitsets<Lanes> &Bits, const std::vector<unsigned int> &Sources, std::size_t first, std::size_t last, Reach reach) const
+    {
+        Bits.prepare(this->_id_);
+        for(std::size_t i = first; i < last; ++i)
+        {
+            std::uint64_t *Visit = &Bits.Visit[std::size_t(Sources[i]) * Lanes];
+            std::uint64_t queued = 0;
+            for(std::size_t l = 0; l < Lanes; ++l)
+                queued |= Visit[l];
+            if(queued == 0)
+                Bits.Frontier.push_back(Sources[i]);
+
+            std::size_t bit = i - first;
+            Visit[bit / 64] |= std::uint64_t(1) << (bit % 64);
+            Bits.Seen[std::size_t(Sources[i]) * Lanes + bit / 64] |= std::uint64_t(1) << (bit % 64);
+        }
+        for(unsigned int vertex : Bits.Frontier)
+            reach(vertex, 0, 0, &Bits.Visit[std::size_t(vertex) * Lanes]);
 
-                // If this vertex is already visited from other end, this is the intersection point. Search can be stopped.
-                if(s_Visited.find(vertex) != s_Visited.end())
+        std::uint64_t Discovered[Lanes];
+        for(std::size_t level = 1; !Bits.Frontier.empty(); ++level)
+        {
+            for(unsigned int vertex : Bits.Frontier)
+            {
+                const std::uint64_t *Visit = &Bits.Visit[std::size_t(vertex) * Lanes];
+                for(const Node<W> &node : this->adjacent(vertex))
                 {
-                    // Constructing the path.
-                    std::vector<T> Path;
-                    Path.push_back(this->_id_to_node_.at(vertex));
-                    
-                    int i = vertex;
-                    while (i != start)
+                    std::uint64_t *Seen = &Bits.Seen[std::size_t(node.vertex) * Lanes];
+                    std::uint64_t found = 0;
+                    for(std::size_t l = 0; l < Lanes; ++l)
                     {
-                        Path.push_back(this->_id_to_node_.at(s_Prev[i]));
-                        i = s_Prev[i];
+                        Discovered[l] = Visit[l] & ~Seen[l];
+                        found |= Discovered[l];
                     }
-                    reverse(Path.begin(), Path.end());
-                    
-                    i = vertex;
-                    while(i != end)
+                    if(found == 0)
+                        continue;
+
+                    std::uint64_t *Next = &Bits.Next[std::size_t(node.vertex) * Lanes];
+                    std::uint64_t queued = 0;
+                    for(std::size_t l = 0; l < Lanes; ++l)
                     {
-                        Path.push_back(this->_id_to_node_.at(e_Prev[i]));
-                        i = e_Prev[i];
+                        queued |= Next[l];
+                        Next[l] |= Discovered[l];
+                        Seen[l] |= Discovered[l];
                     }
-
-                    return std::tuple<double, std::vector<T>>(dist + s_Visited.at(vertex), Path);
+                    if(queued == 0)
+                        Bits.NextFrontier.push_back(node.vertex);
+                    reach(node.vertex, vertex, level, Discovered);
                 }
+            }
 
-                for (const Node<W> &node : this->_ADJACENCY_LIST_.at(vertex))
+            // The next level becomes the current one. The old bitsets are cleared through the frontier, not wholesale.
+            for(unsigned int vertex : Bits.Frontier)
+                for(std::size_t l = 0; l < Lanes; ++l)
+                    Bits.Visit[std::size_t(vertex) * Lanes + l] = 0;
+            Bits.Visit.swap(Bits.Next);
+            Bits.Frontier.swap(Bits.NextFrontier);
+            Bits.NextFrontier.clear();
+        }
+    }
+
+    // The next vertex from a source to a vertex first reached at level 1 is the vertex itself, and at a deeper level the one towards its parent.
+    // A parent is one level closer to every source it passes on, so the next vertices spell out shortest paths.
+    template<typename T, typename W>
+    void undirected_graph<T, W>::breadthFirstAllPairs(const std::vector<unsigned int> &Ids, dense_matrix<double> &Dist, dense_matrix<std::uint32_t> &Next) const
+    {
+        // Vertices are numbered by their position in Ids(their row in the matrices).
+        std::size_t V = Ids.size();
+        std::vector<std::uint32_t> Row(this->_id_, 0);
+        for(std::size_t r = 0; r < V; ++r)
+            Row[Ids[r]] = r;
+
+        Dist = dense_matrix<double>(V, std::numeric_limits<double>::infinity());
+        Next = dense_matrix<std::uint32_t>(V, std::numeric_limits<std::uint32_t>::max());
+
+        // Batches of sources are spread across all the cores. Every row belongs to one batch, so it has a single writer.
+        typedef source_bitsets<4> bitsets;
+        std::size_t batches = (V + bitsets::sources() - 1) / bitsets::sources();
+        parallelFor(batches, defaultThreads(), [&](unsigned int, std::size_t first, std::size_t last)
+        {
+            bitsets Bits;
+            for(std::size_t b = first; b < last; ++b)
+            {
+                std::size_t base = b * bitsets::sources();
+                multiSourceBFS(Bits, Ids, base, std::min(V, base + bitsets::sources()), [&](unsigned int id, unsigned int parent, std::size_t level, const std::uint64_t *Sources)
                 {
-                    if (e_Visited.find(node.vertex) == e_Visited.end())
+                    std::uint32_t j = Row[id];
+                    for(std::size_t l = 0; l < 4; ++l)
                     {
-                        e_Prev[node.vertex] = vertex;
-                        e_Q.push(pair(node.vertex, dist + 1));
-                        e_Visited[node.vertex] = dist + 1;
+                        for(std::uint64_t bits = Sources[l]; bits != 0; bits &= bits - 1)
+                        {
+                            std::size_t r = base + l * 64 + lowestBit(bits);
+                            Dist[r][j] = level;
+                            if(level == 1)
+                                Next[r][j] = j;
+                            else if(level > 1)
+                                Next[r][j] = Next[r][Row[parent]];
+                        }
+                    }
+                });
+            }
+        });
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::breadthFirstStep(search_workspace<double> &Workspace, std::size_t first, std::size_t last, bfs_frontier &Frontier, bool reverse) const
+    {
+        // Top-down steps follow the edges in the direction of the search, bottom-up steps follow them backwards.
+        auto down = [this, reverse](unsigned int id) { return reverse ? this->inAdjacent(id) : this->adjacent(id); };
+        auto up = [this, reverse](unsigned int id) { return reverse ? this->adjacent(id) : this->inAdjacent(id); };
+
+        std::size_t frontierSize = last - first;
+        std::size_t frontierEdges = 0;
+        for(std::size_t i = first; i < last; ++i)
+            frontierEdges += down(Workspace.Touched[i]).size();
+
+        Frontier.choose(frontierSize, frontierEdges, this->_id_, [&]()
+        {
+            std::size_t unexplored = 0;
+            for(unsigned int id = 1; id < this->_id_; ++id)
+                if(!Frontier.Visited.test(id))
+                    unexplored += up(id).size();
+            return unexplored;
+        });
+
+        double level = Workspace.Distance[Workspace.Touched[first]] + 1;
+        auto visit = [&](unsigned int id, unsigned int parent)
+        {
+            Workspace.relax(id, level, parent);
+            Frontier.Visited.set(id);
+            if(Frontier.Unexplored != bfs_frontier::unknown())
+                Frontier.Unexplored -= up(id).size();
+        };
+
+        if(!Frontier.BottomUp)
+        {
+            for(std::size_t i = first; i < last; ++i)
+            {
+                unsigned int vertex = Workspace.Touched[i];
+                for(const Node<W> &node : down(vertex))
+                    if(!Frontier.Visited.test(node.vertex))
+                        visit(node.vertex, vertex);
+            }
+            return;
+        }
+
+        // Every unvisited vertex looks for a parent in the frontier, and stops at the first one.
+        Frontier.Current.reset(this->_id_);
+        for(std::size_t i = first; i < last; ++i)
+            Frontier.Current.set(Workspace.Touched[i]);
+
+        for(std::size_t w = 0; w < Frontier.Visited.words(); ++w)
+        {
+            for(std::uint64_t bits = ~Frontier.Visited.word(w); bits != 0; bits &= bits - 1)
+            {
+                unsigned int id = w * 64 + lowestBit(bits);
+                for(const Node<W> &node : up(id))
+                {
+                    if(Frontier.Current.test(node.vertex))
+                    {
+                        visit(id, node.vertex);
+                        break;
                     }
                 }
             }
         }
+    }
+
+    // Level synchronous BFS from both ends at once(the backward side over in-edges), always expanding the smaller frontier by a whole level.
+    // Before a step the two visited sets are disjoint, so the shortest path is longer than the sum of the two depths; the first vertex the
+    // step reaches that the other side has already visited closes a path of exactly that length plus one, which is therefore the shortest.
+    template<typename T, typename W>
+    unsigned int undirected_graph<T, W>::bidirectionalSearch(search_workspace<double> &Forward, search_workspace<double> &Backward, unsigned int start, unsigned int end) const
+    {
+        bfs_frontier ForwardFrontier;
+        bfs_frontier BackwardFrontier;
+        Forward.prepare(this->_id_);
+        Backward.prepare(this->_id_);
+        ForwardFrontier.reset(this->_id_);
+        BackwardFrontier.reset(this->_id_);
+
+        Forward.relax(start, 0, 0);
+        Backward.relax(end, 0, 0);
+        ForwardFrontier.Visited.set(start);
+        BackwardFrontier.Visited.set(end);
+        if(start == end)
+            return start;
+
+        std::size_t s_first = 0;
+        std::size_t e_first = 0;
+        while(s_first < Forward.Touched.size() && e_first < Backward.Touched.size())
+        {
+            bool forward = Forward.Touched.size() - s_first <= Backward.Touched.size() - e_first;
+            search_workspace<double> &Side = forward ? Forward : Backward;
+            bfs_frontier &Frontier = forward ? ForwardFrontier : BackwardFrontier;
+            const bfs_frontier &Other = forward ? BackwardFrontier : ForwardFrontier;
+            std::size_t &first = forward ? s_first : e_first;
+
+            std::size_t last = Side.Touched.size();
+            breadthFirstStep(Side, first, last, Frontier, !forward);
+            first = last;
+
+            for(std::size_t i = last; i < Side.Touched.size(); ++i)
+                if(Other.Visited.test(Side.Touched[i]))
+                    return Side.Touched[i];
+        }
 
-        return std::tuple<double, std::vector<T>>(std::numeric_limits<double>::infinity(), std::vector<T>());
+        return 0;
     }
 
+    // Runs two eager Dijkstra searches, one from the source over out-edges and one from the destination over in-edges, always expanding the
+    // frontier with the smaller key. Whenever an edge reaches a vertex seen by the other side, the path through it is a candidate(mu).
+    // Once top(forward) + top(backward) >= mu, no undiscovered path can be shorter and the search stops.
     template<typename T, typename W>
-    std::tuple<std::unordered_map<unsigned int, std::unordered_map<unsigned int, double>>, std::unordered_map<unsigned int, std::unordered_map<unsigned int, unsigned int>>> undirected_graph<T, W>::floydWarshall() const
+    unsigned int undirected_graph<T, W>::bidirectionalDijkstra(search_workspace<distance_type> &Forward, search_workspace<distance_type> &Backward, unsigned int start, unsigned int end) const
     {
-        std::unordered_map<unsigned int, std::unordered_map<unsigned int, double>> Distance;
-        std::unordered_map<unsigned int, std::unordered_map<unsigned int, unsigned int>> Next;
+        const distance_type inf = search_workspace<distance_type>::infinity();
 
-        // Initialization phase.
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edge_list : this->_ADJACENCY_LIST_)
+        Forward.prepare(this->_id_);
+        Backward.prepare(this->_id_);
+        Forward.relax(start, 0, 0);
+        Backward.relax(end, 0, 0);
+        if(start == end)
+            return start;
+        Forward.Heap.push(start, 0);
+        Backward.Heap.push(end, 0);
+
+        distance_type best = inf;       // mu, the length of the best path found so far.
+        unsigned int meet = 0;
+
+        while(!Forward.Heap.empty() && !Backward.Heap.empty())
         {
-            for(const std::pair<unsigned int, std::vector<Node<W>>> &edge_list2 : this->_ADJACENCY_LIST_)
+            // Stopping condition (every path not seen yet is at least as long as the best one).
+            if(best != inf && Forward.Heap.topKey() + Backward.Heap.topKey() >= best)
+                break;
+
+            bool forward = Forward.Heap.topKey() <= Backward.Heap.topKey();
+            search_workspace<distance_type> &Self = forward ? Forward : Backward;
+            search_workspace<distance_type> &Other = forward ? Backward : Forward;
+
+            unsigned int vertex = Self.Heap.pop();
+            for(const Node<W> &node : forward ? this->adjacent(vertex) : this->inAdjacent(vertex))
             {
-                // Diagonal entries are zero(even if they have self loops).
-                if(edge_list.first == edge_list2.first)
-                    Distance[edge_list.first][edge_list2.first] = 0;
-                else
-                    Distance[edge_list.first][edge_list2.first] = std::numeric_limits<double>::infinity();
-                Next[edge_list.first][edge_list2.first] = 0;
+                // If next better distance is found, update it.
+                distance_type newDist = Self.Distance[vertex] + node.weight;
+                if(newDist < Self.Distance[node.vertex])
+                {
+                    Self.relax(node.vertex, newDist, vertex);
+                    Self.Heap.pushOrDecrease(node.vertex, newDist);
+                }
+
+                // If the other side has reached this vertex too, the path through it is a candidate.
+                if(Other.Distance[node.vertex] != inf && Self.Distance[node.vertex] + Other.Distance[node.vertex] < best)
+                {
+                    best = Self.Distance[node.vertex] + Other.Distance[node.vertex];
+                    meet = node.vertex;
+                }
+            }
+        }
+
+        return meet;
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::floydWarshall(const std::vector<unsigned int> &Ids, dense_matrix<double> &Dist, dense_matrix<std::uint32_t> &Next) const
+    {
+        // Vertices are numbered by their position in Ids(their row in the matrices).
+        std::size_t V = Ids.size();
+        std::vector<std::size_t> Row(this->_id_, 0);
+        for(std::size_t r = 0; r < V; ++r)
+            Row[Ids[r]] = r;
+
+        // Initialization phase. The padding rows and columns stay at infinity, so they never shorten a path.
+        // Hop[i][j] is the row of the vertex that follows i on the best known path to j, -1 if there is none.
+        // Edges[i][j] is the number of edges on that path. Among equally short paths the one with fewer edges wins, so every hop is
+        // closer to the destination in edges and following the hops terminates even across zero weight cycles.
+        Dist = dense_matrix<double>(V, std::numeric_limits<double>::infinity());
+        dense_matrix<std::int64_t> Edges(V, 0);
+        dense_matrix<std::int64_t> Hop(V, -1);
+        for(std::size_t i = 0; i < V; ++i)
+        {
+            // Diagonal entries are zero(even if they have self loops).
+            Dist[i][i] = 0;
+            for(const Node<W> &node : this->adjacent(Ids[i]))
+            {
+                std::size_t j = Row[node.vertex];
+                if(i != j && node.weight < Dist[i][j])
+                {
+                    Dist[i][j] = node.weight;
+                    Edges[i][j] = 1;
+                    Hop[i][j] = j;
+                }
             }
         }
 
-        // Distance[i][j] = adj_mat[i][j], next[i][j] = j.
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edge_list : this->_ADJACENCY_LIST_)
+        // Execute the blocked Floyd-Warshall Algorithm, one tile row/column k at a time:
+        // 1. the diagonal tile (k, k) relaxes itself,
+        // 2. the other tiles of row k and column k relax through it,
+        // 3. every remaining tile (i, j) relaxes through the tiles (i, k) and (k, j).
+        // The tiles of phases 2 and 3 are independent of each other, so they are shared among the threads.
+        std::int64_t cap = V;         // Saturation of the edge counts, see minPlusRow.
+        std::size_t blocks = Dist.stride() / Dist.tile();
+        unsigned int threads = std::max<std::size_t>(1, std::min<std::size_t>(defaultThreads(), blocks));
+        thread_barrier Barrier(threads);
+
+        parallelFor(threads, threads, [&](unsigned int t, std::size_t, std::size_t)
         {
-            for(const Node<W> &node : edge_list.second)
+            for(std::size_t k = 0; k < blocks; ++k)
             {
-                if(edge_list.first != node.vertex)
-                    Distance[edge_list.first][node.vertex] = node.weight;
-                Next[edge_list.first][node.vertex] = node.vertex;
+                if(t == 0)
+                    minPlusTile(Dist, Edges, Hop, cap, k, k, k);
+                Barrier.wait();
+
+                for(std::size_t task = t; task < 2 * (blocks - 1); task += threads)
+                {
+                    std::size_t b = task / 2 + (task / 2 >= k);
+                    if(task % 2 == 0)
+                        minPlusTile(Dist, Edges, Hop, cap, k, b, k);
+                    else
+                        minPlusTile(Dist, Edges, Hop, cap, b, k, k);
+                }
+                Barrier.wait();
+
+                for(std::size_t i = t; i < blocks; i += threads)
+                    for(std::size_t j = 0; j < blocks; ++j)
+                        if(i != k && j != k)
+                            minPlusTile(Dist, Edges, Hop, cap, i, j, k);
+                Barrier.wait();
             }
+        });
+
+        // A vertex is on a negative cycle iff its distance to itself became negative.
+        // The distance is -infinity between every pair of vertices with such a vertex on a path from one to the other.
+        // Vertices that reach each other reach the same vertices, so one of each such group is enough.
+        // Marking keeps the entries finite(or -infinity), so it can be done in place.
+        std::vector<std::size_t> Cycles;
+        for(std::size_t r = 0; r < V; ++r)
+        {
+            if(!(Dist[r][r] < 0))
+                continue;
+
+            bool redundant = false;
+            for(std::size_t q : Cycles)
+                if(Dist[q][r] != std::numeric_limits<double>::infinity() && Dist[r][q] != std::numeric_limits<double>::infinity())
+                {
+                    redundant = true;
+                    break;
+                }
+            if(!redundant)
+                Cycles.push_back(r);
         }
+        for(std::size_t i = 0; i < V && !Cycles.empty(); ++i)
+            for(std::size_t r : Cycles)
+                if(Dist[i][r] != std::numeric_limits<double>::infinity())
+                    for(std::size_t j = 0; j < V; ++j)
+                        if(Dist[r][j] != std::numeric_limits<double>::infinity())
+                        {
+                            Dist[i][j] = std::numeric_limits<double>::infinity() * -1;
+                            Hop[i][j] = -1;
+                        }
 
-        // Execute Floyd-Warshall Algorithm.
-        for(const std::pair<unsigned int, T> &k : this->_id_to_node_) // k = 0 to V
-            for(const std::pair<unsigned int, T> &i : this->_id_to_node_) // i = 0 to V
-                for(const std::pair<unsigned int, T> &j : this->_id_to_node_) // j = 0 to V
-                    if(Distance[i.first][k.first] + Distance[k.first][j.first] < Distance[i.first][j.first])
-                    {
-                        Distance[i.first][j.first] = Distance[i.first][k.first] + Distance[k.first][j.first];
-                        Next[i.first][j.first] = Next[i.first][k.first];
-                    }
+        Next = dense_matrix<std::uint32_t>(V, std::numeric_limits<std::uint32_t>::max());
+        for(std::size_t i = 0; i < V; ++i)
+            for(std::size_t j = 0; j < V; ++j)
+                if(Hop[i][j] >= 0)
+                    Next[i][j] = Hop[i][j];
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::allPairsSearch(const std::vector<unsigned int> &Ids, dense_matrix<double> &Dist, dense_matrix<std::uint32_t> &Next) const
+    {
+        // Unit weights: one multi-source BFS per batch of sources, O(V * E / 256) edge scans.
+        if(!isWeighted)
+        {
+            breadthFirstAllPairs(Ids, Dist, Next);
+            return;
+        }
+
+        // Johnson costs O(V * E * log V), Floyd-Warshall O(V^3).
+        double V = Ids.size();
+        double E = 0;
+        for(unsigned int id : Ids)
+            E += this->adjacent(id).size();
 
-        // Execute Floyd-Warshall Algorithm a second time to detect negative cycles.
-        for(const std::pair<unsigned int, T> &k : this->_id_to_node_) // k = 0 to V
-            for(const std::pair<unsigned int, T> &i : this->_id_to_node_) // i = 0 to V
-                for(const std::pair<unsigned int, T> &j : this->_id_to_node_) // j = 0 to V
-                    if(Distance[i.first][k.first] + Distance[k.first][j.first] < Distance[i.first][j.first])
+        if(E * std::max(1.0, std::log2(V)) < V * V)
+            johnson(Ids, Dist, Next);
+        else
+            floydWarshall(Ids, Dist, Next);
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::johnson(const std::vector<unsigned int> &Ids, dense_matrix<double> &Dist, dense_matrix<std::uint32_t> &Next) const
+    {
+        // Vertices are numbered by their position in Ids(their row in the matrices).
+        std::size_t V = Ids.size();
+        std::vector<std::uint32_t> Row(this->_id_, 0);
+        for(std::size_t r = 0; r < V; ++r)
+            Row[Ids[r]] = r;
+
+        // Potentials: h(v) = shortest distance to v from an extra vertex with a 0 weight edge to every vertex. They make every reduced weight
+        // non-negative. Graphs without negative weights need none. A negative cycle cannot be reweighted away, Floyd-Warshall handles it.
+        std::vector<double> Potential(this->_id_, 0);
+        if(isNegWeighted)
+        {
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            bellmanFord(Workspace, Ids);
+            for(unsigned int id : Ids)
+            {
+                if(Workspace.Distance[id] == std::numeric_limits<double>::infinity() * -1)
+                {
+                    floydWarshall(Ids, Dist, Next);
+                    return;
+                }
+                Potential[id] = Workspace.Distance[id];
+            }
+        }
+
+        // Every worker fills the rows of its own sources.
+        Dist = dense_matrix<double>(V, std::numeric_limits<double>::infinity());
+        Next = dense_matrix<std::uint32_t>(V, std::numeric_limits<std::uint32_t>::max());
+
+        parallelFor(V, defaultThreads(), [&](unsigned int, std::size_t first, std::size_t last)
+        {
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            indexed_heap<std::pair<double, unsigned int>> Heap;
+            std::vector<unsigned int> Edges(this->_id_, 0);     // (id - edges on the path) mapping, valid for the reached ids.
+            std::vector<unsigned int> Hop(this->_id_, 0);       // (id - first vertex after the source on the path) mapping, 0 if unknown.
+            std::vector<unsigned int> Chain;
+
+            for(std::size_t r = first; r < last; ++r)
+            {
+                unsigned int i = Ids[r];
+                reducedDijkstra(Workspace, Heap, Edges, i, Potential);
+
+                // The next hop of a vertex is the one of its parent, or itself if its parent is the source.
+                for(unsigned int j : Workspace.Touched)
+                {
+                    if(j == i)
+                        continue;
+
+                    unsigned int at = j;
+                    Chain.clear();
+                    while(Hop[at] == 0 && Workspace.Prev[at] != i)
                     {
-                        Distance[i.first][j.first] = std::numeric_limits<double>::infinity() * -1;
-                        Next[i.first][j.first] = 0;
+                        Chain.push_back(at);
+                        at = Workspace.Prev[at];
                     }
+                    if(Hop[at] == 0)
+                        Hop[at] = at;
+                    for(unsigned int c : Chain)
+                        Hop[c] = Hop[at];
+                }
 
-        return std::tuple<std::unordered_map<unsigned int, std::unordered_map<unsigned int, double>>, std::unordered_map<unsigned int, std::unordered_map<unsigned int, unsigned int>>>(Distance, Next);
+                // Undo the reweighting.
+                for(unsigned int j : Workspace.Touched)
+                {
+                    Dist[r][Row[j]] = Workspace.Distance[j] - Potential[i] + Potential[j];
+                    if(j != i)
+                        Next[r][Row[j]] = Row[Hop[j]];
+                }
+                Dist[r][r] = 0;
+
+                for(unsigned int j : Workspace.Touched)
+                    Hop[j] = 0;
+            }
+        });
+    }
+
+    // Ties in distance are broken by the number of edges, so that the next hop of every source is also closer to the destination in edges.
+    // Otherwise zero weight edges could make the next hops of two different sources point at each other.
+    template<typename T, typename W>
+    void undirected_graph<T, W>::reducedDijkstra(search_workspace<double> &Workspace, indexed_heap<std::pair<double, unsigned int>> &Heap, std::vector<unsigned int> &Edges, unsigned int start, const std::vector<double> &Potential) const
+    {
+        Workspace.prepare(this->_id_);
+        Heap.reserve(this->_id_);
+        Workspace.relax(start, 0, 0);
+        Edges[start] = 0;
+        Heap.push(start, std::make_pair(0.0, 0u));
+
+        while(!Heap.empty())
+        {
+            start = Heap.pop();
+            for(const Node<W> &node : this->adjacent(start))
+            {
+                // Reduced weights are non-negative up to rounding, which must not make a distance go below its parent's.
+                double reduced = std::max(0.0, node.weight + Potential[start] - Potential[node.vertex]);
+                std::pair<double, unsigned int> newKey(Workspace.Distance[start] + reduced, Edges[start] + 1);
+                if(newKey.first < Workspace.Distance[node.vertex] || (newKey.first == Workspace.Distance[node.vertex] && newKey.second < Edges[node.vertex]))
+                {
+                    Workspace.relax(node.vertex, newKey.first, start);
+                    Edges[node.vertex] = newKey.second;
+                    Heap.pushOrDecrease(node.vertex, newKey);
+                }
+            }
+        }
+    }
+
+    template<typename T, typename W>
+    template<typename D>
+    double undirected_graph<T, W>::distanceTo(const search_workspace<D> &Workspace, unsigned int id)
+    {
+        if(Workspace.Distance[id] == search_workspace<D>::infinity())
+            return std::numeric_limits<double>::infinity();
+        return Workspace.Distance[id];
+    }
+
+    template<typename T, typename W>
+    template<typename D>
+    std::vector<T> undirected_graph<T, W>::pathTo(const search_workspace<D> &Workspace, unsigned int start, unsigned int end) const
+    {
+        // If the vertex is unreachable || is a part of negative weight cycle, return empty path.
+        std::vector<T> Path;
+        double dist = distanceTo(Workspace, end);
+        if(dist == std::numeric_limits<double>::infinity() || dist == std::numeric_limits<double>::infinity() * -1)
+            return Path;
+
+        // Reconstructing the path.
+        for(unsigned int curr = end; ; curr = Workspace.Prev[curr])
+        {
+            Path.push_back(this->_id_to_node_[curr]);
+            if(curr == start) break;
+        }
+        std::reverse(Path.begin(), Path.end());
+
+        return Path;
+    }
+
+    template<typename T, typename W>
+    template<typename D>
+    std::vector<T> undirected_graph<T, W>::pathThrough(const search_workspace<D> &Forward, const search_workspace<D> &Backward, unsigned int start, unsigned int end, unsigned int meet) const
+    {
+        // If the searches never met, return empty path.
+        if(meet == 0)
+            return std::vector<T>();
+
+        // Source to the meeting vertex from the forward search, then on to the destination along the backward search's parents.
+        std::vector<T> Path = pathTo(Forward, start, meet);
+        for(unsigned int curr = meet; curr != end; )
+        {
+            curr = Backward.Prev[curr];
+            Path.push_back(this->_id_to_node_[curr]);
+        }
+
+        return Path;
+    }
+
+    template<typename T, typename W>
+    template<typename D>
+    std::unordered_map<T, double> undirected_graph<T, W>::distancesFrom(const search_workspace<D> &Workspace) const
+    {
+        // Forming the Distance map with the actual node names.
+        std::unordered_map<T, double> DistanceFinal;
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(this->isVertex(id))
+                DistanceFinal[this->_id_to_node_[id]] = distanceTo(Workspace, id);
+
+        return DistanceFinal;
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,325 @@
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include "undirected_graph.hpp"
+
+namespace graph
+{
+    // Result of a single source shortest path search: the distance and the parent of every vertex, in arrays indexed by vertex id.
+    // A path is only spelled out when it is asked for(by walking the parents), so the tree costs O(V) memory however deep it is.
+    // The vertices are also laid out in preorder, which makes every subtree a contiguous run.
+    // The tree refers to the graph for the vertex labels, so the graph must outlive it. Later changes to the edges are not followed.
+    template<typename T, typename W>
+    class undirected_graph<T, W>::shortest_path_tree
+    {
+        friend class undirected_graph<T, W>;
+
+        private:
+            const undirected_graph<T, W> *_graph_{nullptr};
+            unsigned int _source_{0};                   // Id of the source, 0 for an empty tree.
+            std::vector<double> _distance_;             // (id - bestDistance) mapping.
+            std::vector<unsigned int> _prev_;           // (child - parent) mapping, 0 if there is no parent.
+            std::vector<unsigned int> _order_;          // Ids of the tree(the vertices at a finite distance) in preorder.
+            std::vector<unsigned int> _enter_;          // (id - position in _order_) mapping.
+            std::vector<unsigned int> _size_;           // (id - number of vertices in its subtree) mapping, 0 if not in the tree.
+
+            // Given the graph, the workspace of a search and the source, copies the distances and parents and lays out the tree.
+            template<typename D>
+            shortest_path_tree(const undirected_graph<T, W> &, const search_workspace<D> &, unsigned int);
+
+            // Returns the id of the vertex, 0 if it is not a vertex of the graph.
+            unsigned int idOf(const T &) const;
+
+        public:
+            // Walks a path backwards one vertex at a time, from the destination to the source, following the parents.
+            class path_iterator
+            {
+                friend class shortest_path_tree;
+
+                private:
+                    const shortest_path_tree *_tree_{nullptr};
+                    unsigned int _at_{0};               // Id of the current vertex, 0 past the end.
+
+                    path_iterator(const shortest_path_tree *tree, unsigned int at) : _tree_ (tree), _at_ (at)
+                    {
+                    }
+
+                public:
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef T value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef const T* pointer;
+                    typedef const T& reference;
+
+                    path_iterator() = default;
+
+                    bool operator==(const path_iterator &rhs) const
+                    {
+                        return _at_ == rhs._at_;
+                    }
+                    bool operator!=(const path_iterator &rhs) const
+                    {
+                        return _at_ != rhs._at_;
+                    }
+                    path_iterator& operator++()
+                    {
+                        _at_ = _at_ == _tree_->_source_ ? 0 : _tree_->_prev_[_at_];
+                        return *this;
+                    }
+                    path_iterator operator++(int)
+                    {
+                        path_iterator old = *this;
+                        ++*this;
+                        return old;
+                    }
+                    const T& operator*() const
+                    {
+                        return _tree_->_graph_->_id_to_node_[_at_];
+                    }
+                    const T* operator->() const
+                    {
+                        return &_tree_->_graph_->_id_to_node_[_at_];
+                    }
+            };
+
+            // The vertices of one path, from the destination back to the source, for use in range-based for loops.
+            class path_range
+            {
+                public:
+                    path_iterator first;
+                    path_iterator last;
+
+                    path_iterator begin() const
+                    {
+                        return first;
+                    }
+                    path_iterator end() const
+                    {
+                        return last;
+                    }
+                    bool empty() const
+                    {
+                        return first == last;
+                    }
+            };
+
+            // Default constructor(an empty tree).
+            shortest_path_tree();
+
+            /*
+             *  If the destination is not reachable, distance is inf. If the destination is a part of negative cycle, distance is -inf.
+             *  If the vertex is invalid(or the tree is empty), distance is -1.
+             *  If the destination is not reachable || is a part of negative cycle || If the vertex is invalid, path is EMPTY.
+             */
+            // Given a vertex, returns the length of shortest path from the source to it, in O(1).
+            double shortestDistance(T) const;
+            // Given a vertex, returns the shortest path from the source to it.
+            std::vector<T> shortestPath(T) const;
+            // Given a vertex, returns the shortest path from the source to it as a range that is walked lazily, from the vertex back to the source.
+            path_range pathRange(T) const;
+
+            // Given a vertex, returns the vertices whose shortest path from the source passes through it(itself included), in preorder.
+            std::vector<T> subtree(T) const;
+            // Given a vertex, returns the number of vertices whose shortest path from the source passes through it(itself included).
+            std::size_t subtreeSize(T) const;
+            // Given two vertices, returns true if the shortest path from the source to the second one passes through the first one, in O(1).
+            bool inSubtree(T, T) const;
+
+            // Returns the source of the tree.
+            T source() const;
+            // Returns the number of vertices at a finite distance from the source.
+            std::size_t size() const;
+            // Returns true if the tree is empty(e.g. it was asked for an invalid source).
+            bool empty() const;
+    };
+
+    template<typename T, typename W>
+    typename undirected_graph<T, W>::shortest_path_tree undirected_graph<T, W>::singleSourceShortestPaths(T start, unsigned int threads) const
+    {
+        // If the vertex is invalid, return empty tree.
+        if(this->_node_to_id_.find(start) == this->_node_to_id_.end())
+            return shortest_path_tree();
+
+
+        unsigned int s = this->_node_to_id_.at(start);
+
+        // Use Bellman-Ford for negative weighted graphs, Breadth First Search for unweighted graphs, Dijkstra for others.
+        if(isNegWeighted)
+        {
+            search_workspace<double> &Workspace = threadWorkspace<double>();
+            bellmanFord(Workspace, s);
+            return shortest_path_tree(*this, Workspace, s);
+        }
+        else
+        {
+            if(isWeighted)
+            {
+                search_workspace<distance_type> &Workspace = threadWorkspace<distance_type>();
+                Dijkstra(Workspace, s);
+                return shortest_path_tree(*this, Workspace, s);
+            }
+            else
+            {
+                search_workspace<double> &Workspace = threadWorkspace<double>();
+                breadthFirstSearch(Workspace, s, threads);
+                return shortest_path_tree(*this, Workspace, s);
+            }
+        }
+    }
+
+    template<typename T, typename W>
+    undirected_graph<T, W>::shortest_path_tree::shortest_path_tree()
+    {
+    }
+
+    template<typename T, typename W>
+    template<typename D>
+    undirected_graph<T, W>::shortest_path_tree::shortest_path_tree(const undirected_graph<T, W> &G, const search_workspace<D> &Workspace, unsigned int start)
+        : _graph_ (&G)
+        , _source_ (start)
+        , _distance_ (G._id_, std::numeric_limits<double>::infinity())
+        , _prev_ (G._id_, 0)
+        , _enter_ (G._id_, 0)
+        , _size_ (G._id_, 0)
+    {
+        // Only the vertices reached by the search differ from the defaults.
+        for(unsigned int id : Workspace.Touched)
+        {
+            _distance_[id] = distanceTo(Workspace, id);
+            _prev_[id] = Workspace.Prev[id];
+        }
+
+        // Children of every vertex of the tree, in CSR form. Vertices at -infinity are left out: their parents may form a cycle.
+        std::vector<unsigned int> Offsets(G._id_ + 1, 0);
+        for(unsigned int id : Workspace.Touched)
+            if(id != start && _distance_[id] != std::numeric_limits<double>::infinity() * -1)
+                ++Offsets[_prev_[id] + 1];
+        for(std::size_t id = 0; id < G._id_; ++id)
+            Offsets[id + 1] += Offsets[id];
+        std::vector<unsigned int> Children(Offsets[G._id_]);
+        std::vector<unsigned int> Fill(Offsets.begin(), Offsets.end() - 1);
+        for(unsigned int id : Workspace.Touched)
+            if(id != start && _distance_[id] != std::numeric_limits<double>::infinity() * -1)
+                Children[Fill[_prev_[id]]++] = id;
+
+        // Preorder walk from the source. The size of a subtree is known once the walk has left it.
+        if(_distance_[start] == std::numeric_limits<double>::infinity() * -1)
+            return;
+        std::vector<unsigned int> Stack(1, start);
+        while(!Stack.empty())
+        {
+            unsigned int vertex = Stack.back();
+            Stack.pop_back();
+            _enter_[vertex] = _order_.size();
+            _order_.push_back(vertex);
+            for(unsigned int i = Offsets[vertex]; i < Offsets[vertex + 1]; ++i)
+                Stack.push_back(Children[i]);
+        }
+        for(std::size_t i = _order_.size(); i-- > 0; )
+        {
+            unsigned int vertex = _order_[i];
+            _size_[vertex] += 1;
+            if(vertex != start)
+                _size_[_prev_[vertex]] += _size_[vertex];
+        }
+    }
+
+    template<typename T, typename W>
+    unsigned int undirected_graph<T, W>::shortest_path_tree::idOf(const T &vertex) const
+    {
+        if(_graph_ == nullptr)
+            return 0;
+
+        typename std::unordered_map<T, unsigned int>::const_iterator it = _graph_->_node_to_id_.find(vertex);
+        if(it == _graph_->_node_to_id_.end() || it->second >= _prev_.size())
+            return 0;
+        return it->second;
+    }
+
+    template<typename T, typename W>
+    double undirected_graph<T, W>::shortest_path_tree::shortestDistance(T vertex) const
+    {
+        // If the vertex is invalid, return -1.
+        unsigned int id = idOf(vertex);
+        if(id == 0)
+            return -1;
+
+        return _distance_[id];
+    }
+
+    template<typename T, typename W>
+    std::vector<T> undirected_graph<T, W>::shortest_path_tree::shortestPath(T vertex) const
+    {
+        path_range Range = pathRange(vertex);
+        std::vector<T> Path(Range.begin(), Range.end());
+        std::reverse(Path.begin(), Path.end());
+        return Path;
+    }
+
+    template<typename T, typename W>
+    typename undirected_graph<T, W>::shortest_path_tree::path_range undirected_graph<T, W>::shortest_path_tree::pathRange(T vertex) const
+    {
+        path_range Range;
+
+        // If the vertex is invalid || is unreachable || is a part of negative weight cycle, return empty range.
+        unsigned int id = idOf(vertex);
+        if(id == 0 || _size_[id] == 0)
+            return Range;
+
+        Range.first = path_iterator(this, id);
+        Range.last = path_iterator(this, 0);
+        return Range;
+    }
+
+    template<typename T, typename W>
+    std::vector<T> undirected_graph<T, W>::shortest_path_tree::subtree(T vertex) const
+    {
+        std::vector<T> Subtree;
+        unsigned int id = idOf(vertex);
+        if(id == 0 || _size_[id] == 0)
+            return Subtree;
+
+        Subtree.reserve(_size_[id]);
+        for(unsigned int i = _enter_[id]; i < _enter_[id] + _size_[id]; ++i)
+            Subtree.push_back(_graph_->_id_to_node_[_order_[i]]);
+        return Subtree;
+    }
+
+    template<typename T, typename W>
+    std::size_t undirected_graph<T, W>::shortest_path_tree::subtreeSize(T vertex) const
+    {
+        unsigned int id = idOf(vertex);
+        return id == 0 ? 0 : _size_[id];
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::shortest_path_tree::inSubtree(T root, T vertex) const
+    {
+        unsigned int r = idOf(root);
+        unsigned int v = idOf(vertex);
+        if(r == 0 || v == 0 || _size_[r] == 0 || _size_[v] == 0)
+            return false;
+
+        return _enter_[r] <= _enter_[v] && _enter_[v] < _enter_[r] + _size_[r];
+    }
+
+    template<typename T, typename W>
+    T undirected_graph<T, W>::shortest_path_tree::source() const
+    {
+        return _source_ == 0 ? T() : _graph_->_id_to_node_[_source_];
+    }
+
+    template<typename T, typename W>
+    std::size_t undirected_graph<T, W>::shortest_path_tree::size() const
+    {
+        return _order_.size();
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::shortest_path_tree::empty() const
+    {
+        return _source_ == 0;
+    }
+}
+
+#endif
@@ -0,0 +1,1233 @@
+// Randomized checks of the library against plain reference algorithms(a queue BFS, Bellman-Ford, brute force) or its own serial code.
+// The parallel engines take over from lowered thresholds, so they run on graphs small enough for the references.
+// Build and run with "make test". Prints one line per check and exits with 1 if any of them failed.
+#define GRAPH_PARALLEL_BFS_THRESHOLD 16
+#define GRAPH_PARALLEL_SCC_THRESHOLD 8
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <tuple>
+#include <set>
+#include <limits>
+#include <algorithm>
+#include "Graph.hpp"
+
+namespace
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    int failures = 0;
+
+    void report(const char *name, int errors)
+    {
+        std::printf("%-56s %s\n", name, errors == 0 ? "ok" : "FAILED");
+        if(errors != 0)
+            failures++;
+    }
+
+    // A random edge list over the vertices [0, n): 'edges' edges with weights in [low, high], and optionally only from lower to higher
+    // vertices(a DAG). Duplicates and self loops are kept, the graphs have to cope with them.
+    std::vector<std::tuple<int, int, int>> randomEdges(std::mt19937 &rng, int n, int edges, int low, int high, bool dag)
+    {
+        std::vector<std::tuple<int, int, int>> Edges;
+        for(int i = 0; i < edges; ++i)
+        {
+            int a = rng() % n, b = rng() % n;
+            if(dag && a >= b)
+                continue;
+            Edges.push_back(std::make_tuple(a, b, low + static_cast<int>(rng() % (high - low + 1))));
+        }
+        return Edges;
+    }
+
+    // Builds a graph over the vertices [0, n), so that every vertex exists even without edges.
+    template<typename T, typename W>
+    void build(graph::undirected_graph<T, W> &G, int n, const std::vector<std::tuple<int, int, int>> &Edges)
+    {
+        std::vector<std::tuple<T, T, W>> Weighted;
+        for(const std::tuple<int, int, int> &e : Edges)
+            Weighted.push_back(std::make_tuple(std::get<0>(e), std::get<1>(e), static_cast<W>(std::get<2>(e))));
+        for(int v = 0; v < n; ++v)
+            G.addVertex(v);
+        G.addEdges(Weighted);
+    }
+
+    // Reference adjacency lists(both directions for undirected graphs).
+    std::vector<std::vector<std::pair<int, int>>> adjacency(int n, const std::vector<std::tuple<int, int, int>> &Edges, bool undirected)
+    {
+        std::vector<std::vector<std::pair<int, int>>> Adj(n);
+        for(const std::tuple<int, int, int> &e : Edges)
+        {
+            Adj[std::get<0>(e)].push_back(std::make_pair(std::get<1>(e), std::get<2>(e)));
+            if(undirected && std::get<0>(e) != std::get<1>(e))
+                Adj[std::get<1>(e)].push_back(std::make_pair(std::get<0>(e), std::get<2>(e)));
+        }
+        return Adj;
+    }
+
+    // The same edges, reversed.
+    std::vector<std::tuple<int, int, int>> reversed(const std::vector<std::tuple<int, int, int>> &Edges)
+    {
+        std::vector<std::tuple<int, int, int>> Reversed;
+        for(const std::tuple<int, int, int> &e : Edges)
+            Reversed.push_back(std::make_tuple(std::get<1>(e), std::get<0>(e), std::get<2>(e)));
+        return Reversed;
+    }
+
+    std::vector<double> referenceBFS(const std::vector<std::vector<std::pair<int, int>>> &Adj, int source)
+    {
+        std::vector<double> Distance(Adj.size(), inf);
+        std::vector<int> Queue(1, source);
+        Distance[source] = 0;
+        for(std::size_t i = 0; i < Queue.size(); ++i)
+            for(const std::pair<int, int> &e : Adj[Queue[i]])
+                if(Distance[e.first] == inf)
+                {
+                    Distance[e.first] = Distance[Queue[i]] + 1;
+                    Queue.push_back(e.first);
+                }
+        return Distance;
+    }
+
+    // Bellman-Ford, then as many rounds again to spread -inf from every vertex that still improves(i.e. is reached through a negative cycle).
+    // Stops at the first round that changes nothing.
+    std::vector<double> referenceBellmanFord(const std::vector<std::vector<std::pair<int, int>>> &Adj, int source)
+    {
+        std::size_t n = Adj.size();
+        std::vector<double> Distance(n, inf);
+        Distance[source] = 0;
+        bool changed = true;
+        for(std::size_t round = 0; round < 2 * n && changed; ++round)
+        {
+            changed = false;
+            for(std::size_t u = 0; u < n; ++u)
+                for(const std::pair<int, int> &e : Adj[u])
+                    if(Distance[u] != inf && Distance[u] + e.second < Distance[e.first])
+                    {
+                        Distance[e.first] = round + 1 >= n ? -inf : Distance[u] + e.second;
+                        changed = true;
+                    }
+        }
+        return Distance;
+    }
+
+    // Length of a path over the edges of Adj, taking the lightest edge between consecutive vertices(inf if two of them are not adjacent).
+    double pathLength(const std::vector<std::vector<std::pair<int, int>>> &Adj, const std::vector<int> &Path)
+    {
+        double length = 0;
+        for(std::size_t i = 0; i + 1 < Path.size(); ++i)
+        {
+            double best = inf;
+            for(const std::pair<int, int> &e : Adj[Path[i]])
+                if(e.first == Path[i + 1])
+                    best = std::min(best, static_cast<double>(e.second));
+            length += best;
+        }
+        return length;
+    }
+
+    // A path must be empty if the destination is unreachable(or behind a negative cycle), and otherwise run from the source to the
+    // destination with the length of its distance.
+    int checkPath(const std::vector<std::vector<std::pair<int, int>>> &Adj, const std::vector<int> &Path, int source, int destination, double expected)
+    {
+        if(expected == inf || expected == -inf)
+            return !Path.empty();
+        return Path.empty() || Path.front() != source || Path.back() != destination || pathLength(Adj, Path) != expected;
+    }
+
+    // Single source distances from a few random sources, and point-to-point queries from them, against Bellman-Ford.
+    template<typename Graph>
+    int checkQueries(std::mt19937 &rng, const Graph &G, const std::vector<std::vector<std::pair<int, int>>> &Adj)
+    {
+        int errors = 0;
+        int n = Adj.size();
+        for(int k = 0; k < 3; ++k)
+        {
+            int source = rng() % n;
+            std::vector<double> Expected = referenceBellmanFord(Adj, source);
+            std::unordered_map<int, double> Distances = G.singleSourceShortestDistances(source);
+            for(int v = 0; v < n; ++v)
+                errors += Distances[v] != Expected[v];
+            for(int q = 0; q < 10; ++q)
+            {
+                int destination = rng() % n;
+                errors += G.shortestDistance(source, destination) != Expected[destination];
+                errors += checkPath(Adj, G.shortestPath(source, destination), source, destination, Expected[destination]);
+            }
+        }
+        return errors;
+    }
+
+    // Renames the vertices of every component by the smallest one, as referenceSCC does. Counts the vertices listed twice or never as errors.
+    int componentOf(const std::vector<std::vector<int>> &Components, std::vector<int> &Component)
+    {
+        int errors = 0;
+        std::fill(Component.begin(), Component.end(), -1);
+        for(const std::vector<int> &C : Components)
+        {
+            int smallest = *std::min_element(C.begin(), C.end());
+            for(int v : C)
+            {
+                errors += Component[v] != -1;
+                Component[v] = smallest;
+            }
+        }
+        errors += std::count(Component.begin(), Component.end(), -1);
+        return errors;
+    }
+
+    // Random simple edges over [0, n): no self loops, and no pair twice(in either direction for undirected graphs).
+    std::vector<std::pair<int, int>> simpleEdges(std::mt19937 &rng, int n, int edges, bool undirected)
+    {
+        std::set<std::pair<int, int>> Seen;
+        std::vector<std::pair<int, int>> Edges;
+        for(int i = 0; i < edges && n > 1; ++i)
+        {
+            int a = rng() % n, b = rng() % n;
+            if(a == b || Seen.count(std::make_pair(a, b)) || (undirected && Seen.count(std::make_pair(b, a))))
+                continue;
+            Seen.insert(std::make_pair(a, b));
+            Edges.push_back(std::make_pair(a, b));
+        }
+        return Edges;
+    }
+
+    std::pair<int, int> ordered(int a, int b)
+    {
+        return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+    }
+
+    // Component of every vertex of an undirected graph, named by its smallest member, without the given vertex and edge(-1 -> none).
+    // The skipped vertex is a component of its own.
+    std::vector<int> referenceComponents(int n, const std::vector<std::pair<int, int>> &Edges, int skipVertex = -1, int skipEdge = -1)
+    {
+        std::vector<std::vector<int>> Adj(n);
+        for(std::size_t i = 0; i < Edges.size(); ++i)
+            if(static_cast<int>(i) != skipEdge && Edges[i].first != skipVertex && Edges[i].second != skipVertex)
+            {
+                Adj[Edges[i].first].push_back(Edges[i].second);
+                Adj[Edges[i].second].push_back(Edges[i].first);
+            }
+
+        std::vector<int> Component(n, -1);
+        for(int v = 0; v < n; ++v)
+        {
+            if(Component[v] != -1)
+                continue;
+            std::vector<int> Stack(1, v);
+            Component[v] = v;
+            while(!Stack.empty())
+            {
+                int u = Stack.back();
+                Stack.pop_back();
+                for(int w : Adj[u])
+                    if(Component[w] == -1)
+                    {
+                        Component[w] = v;
+                        Stack.push_back(w);
+                    }
+            }
+        }
+        return Component;
+    }
+
+    int countComponents(const std::vector<int> &Component)
+    {
+        int count = 0;
+        for(std::size_t v = 0; v < Component.size(); ++v)
+            count += Component[v] == static_cast<int>(v);
+        return count;
+    }
+
+    // Cut vertices and bridges(as (smaller, larger) pairs) of an undirected graph: the vertices and edges whose removal adds a component.
+    void referenceCuts(int n, const std::vector<std::pair<int, int>> &Edges, std::vector<int> &CutVertices, std::vector<std::pair<int, int>> &Bridges)
+    {
+        int components = countComponents(referenceComponents(n, Edges));
+        for(int v = 0; v < n; ++v)
+            if(countComponents(referenceComponents(n, Edges, v)) > components + 1)
+                CutVertices.push_back(v);
+        for(std::size_t i = 0; i < Edges.size(); ++i)
+            if(countComponents(referenceComponents(n, Edges, -1, i)) > components)
+                Bridges.push_back(ordered(Edges[i].first, Edges[i].second));
+        std::sort(Bridges.begin(), Bridges.end());
+    }
+
+    template<typename T, typename W>
+    void build(graph::undirected_graph<T, W> &G, int n, const std::vector<std::pair<int, int>> &Edges)
+    {
+        for(int v = 0; v < n; ++v)
+            G.addVertex(v);
+        G.addEdges(Edges);
+    }
+
+    // Component of every vertex, named by its smallest member: the vertices that reach it and are reached from it.
+    std::vector<int> referenceSCC(const std::vector<std::vector<std::pair<int, int>>> &Adj)
+    {
+        int n = Adj.size();
+        std::vector<std::vector<bool>> Reach(n);
+        for(int v = 0; v < n; ++v)
+        {
+            std::vector<double> Distance = referenceBFS(Adj, v);
+            for(int w = 0; w < n; ++w)
+                Reach[v].push_back(Distance[w] != inf);
+        }
+
+        std::vector<int> Component(n);
+        for(int v = 0; v < n; ++v)
+        {
+            Component[v] = v;
+            for(int w = 0; w < v; ++w)
+                if(Reach[v][w] && Reach[w][v])
+                {
+                    Component[v] = w;
+                    break;
+                }
+        }
+        return Component;
+    }
+
+    // loadEdges interns the vertices with several threads, the graph must not depend on their number.
+    void testLoadEdges(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 1 + rng() % 3000;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % 20000, -2, 5, false);
+
+            graph::directed_graph<int, int> D1, D4;
+            graph::undirected_graph<int, int> U1, U4;
+            D1.loadEdges(Edges, 1);
+            D4.loadEdges(Edges, 4);
+            U1.loadEdges(Edges, 1);
+            U4.loadEdges(Edges, 4);
+            errors += D1 != D4;
+            errors += U1 != U4;
+        }
+        report("loadEdges: 4 threads vs 1", errors);
+    }
+
+    // Dijkstra on the indexed heap, with integral and floating point weights.
+    void testDijkstra(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 1 + rng() % 300;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (4 * n), 0, 20, false);
+            if(trial % 2)
+            {
+                graph::undirected_graph<int, int> U;
+                graph::undirected_graph<int, double> UD;
+                build(U, n, Edges);
+                build(UD, n, Edges);
+                std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, true);
+                errors += checkQueries(rng, U, Adj) + checkQueries(rng, UD, Adj);
+            }
+            else
+            {
+                graph::directed_graph<int, int> D;
+                graph::directed_graph<int, double> DD;
+                build(D, n, Edges);
+                build(DD, n, Edges);
+                std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, false);
+                errors += checkQueries(rng, D, Adj) + checkQueries(rng, DD, Adj);
+            }
+        }
+        report("Dijkstra vs Bellman-Ford", errors);
+    }
+
+    // Integral weights run Dijkstra on a bucket queue: Dial's buckets on a frozen graph whose largest weight is small enough, a radix heap
+    // otherwise. The weights range up to that limit, over few distinct distances, and far beyond it.
+    void testBucketQueues(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 18; ++trial)
+        {
+            int n = 1 + rng() % 300;
+            int high = trial % 3 == 0 ? 4096 : (trial % 3 == 1 ? 3 : 1000000);
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (4 * n), 0, high, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            std::vector<std::vector<std::pair<int, int>>> Directed = adjacency(n, Edges, false), Undirected = adjacency(n, Edges, true);
+            errors += checkQueries(rng, D, Directed) + checkQueries(rng, U, Undirected);
+            D.freeze();
+            U.freeze();
+            errors += checkQueries(rng, D, Directed) + checkQueries(rng, U, Undirected);
+        }
+        report("Dijkstra on Dial's buckets and radix heap", errors);
+    }
+
+    // A* with admissible heuristics: none(zero), the exact distance, and a random fraction of it(admissible but not consistent, so
+    // vertices get reopened).
+    void testAStar(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 1 + rng() % 300;
+            bool undirected = trial % 2;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (4 * n), 0, 20, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+            std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, undirected);
+            std::vector<std::vector<std::pair<int, int>>> Reverse = adjacency(n, reversed(Edges), undirected);
+
+            for(int k = 0; k < 5; ++k)
+            {
+                int source = rng() % n, destination = rng() % n;
+                std::vector<double> Expected = referenceBellmanFord(Adj, source);
+                std::vector<double> Remaining = referenceBellmanFord(Reverse, destination);
+                std::vector<double> Fraction(n);
+                for(double &f : Fraction)
+                    f = (rng() % 1001) / 1000.0;
+
+                for(int kind = 0; kind < 3; ++kind)
+                {
+                    auto h = [&](int v)
+                    {
+                        if(kind == 0 || Remaining[v] == inf)
+                            return 0.0;
+                        return kind == 1 ? Remaining[v] : Fraction[v] * Remaining[v];
+                    };
+                    errors += G.shortestDistance(source, destination, h) != Expected[destination];
+                    errors += checkPath(Adj, G.shortestPath(source, destination, h), source, destination, Expected[destination]);
+                }
+            }
+        }
+        report("A* vs Bellman-Ford", errors);
+    }
+
+    // Bidirectional Dijkstra for point-to-point queries. The frozen graph reads the in-edges of the backward search from its CSR.
+    void testBidirectionalDijkstra(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 1 + rng() % 300;
+            bool undirected = trial % 2;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (4 * n), 1, 20, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+            std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, undirected);
+
+            for(bool frozen : {false, true})
+            {
+                if(frozen)
+                    G.freeze();
+                for(int k = 0; k < 4; ++k)
+                {
+                    int source = rng() % n;
+                    std::vector<double> Expected = referenceBellmanFord(Adj, source);
+                    for(int q = 0; q < 10; ++q)
+                    {
+                        int destination = q == 0 ? source : rng() % n;
+                        errors += G.shortestDistance(source, destination) != Expected[destination];
+                        errors += checkPath(Adj, G.shortestPath(source, destination), source, destination, Expected[destination]);
+                    }
+                }
+            }
+        }
+        report("bidirectional Dijkstra vs Bellman-Ford", errors);
+    }
+
+    // Contraction hierarchy queries(zero weights make ties for the witness searches). Negative weights leave the hierarchy empty.
+    void testContractionHierarchy(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 1 + rng() % 200;
+            bool undirected = trial % 2;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (4 * n), 0, 20, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+            std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, undirected);
+
+            graph::undirected_graph<int, int>::contraction_hierarchy H = G.contractionHierarchy();
+            errors += H.empty();
+            for(int k = 0; k < 5; ++k)
+            {
+                int source = rng() % n;
+                std::vector<double> Expected = referenceBellmanFord(Adj, source);
+                for(int v = 0; v < n; ++v)
+                {
+                    errors += H.shortestDistance(source, v) != Expected[v];
+                    errors += checkPath(Adj, H.shortestPath(source, v), source, v, Expected[v]);
+                }
+            }
+
+            G.addEdge(0, n - 1, -1);
+            errors += !G.contractionHierarchy().empty();
+        }
+        report("contraction hierarchy vs Bellman-Ford", errors);
+    }
+
+    // Parallel delta-stepping with 1 and 4 threads and several bucket widths: chosen from the weights, one far too small for the weights
+    // (it has to be raised), and a wide one.
+    void testDeltaStepping(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 1 + rng() % 500;
+            bool undirected = trial % 2;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (4 * n), 0, trial % 4 < 2 ? 30 : 1000, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+            std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, undirected);
+
+            for(int k = 0; k < 2; ++k)
+            {
+                int source = rng() % n;
+                std::vector<double> Expected = referenceBellmanFord(Adj, source);
+                for(double delta : {0.0, 1e-9, 4.0, 1000.0})
+                    for(unsigned int threads : {1u, 4u})
+                    {
+                        std::unordered_map<int, double> Distances = G.singleSourceShortestDistances(source, delta, threads);
+                        for(int v = 0; v < n; ++v)
+                            errors += Distances[v] != Expected[v];
+                    }
+            }
+        }
+        report("delta-stepping vs Bellman-Ford", errors);
+    }
+
+    // Queue-based Bellman-Ford: negative weights, negative cycles and the vertices reached through them(-inf). On undirected graphs
+    // every negative edge is a negative cycle.
+    void testBellmanFord(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 30; ++trial)
+        {
+            int n = 2 + rng() % 200;
+            bool undirected = trial % 3 == 0;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (3 * n), undirected ? 0 : -3, 20, false);
+            if(trial % 2)
+            {
+                int a = rng() % n, b = rng() % n;
+                Edges.push_back(std::make_tuple(a, b, -2));
+                Edges.push_back(std::make_tuple(b, a, 1));
+            }
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            if(undirected)
+                errors += checkQueries(rng, U, adjacency(n, Edges, true));
+            else
+                errors += checkQueries(rng, D, adjacency(n, Edges, false));
+        }
+        report("queue-based Bellman-Ford vs rounds", errors);
+    }
+
+    // All pairs distances and paths of a directed graph, against Bellman-Ford from every vertex.
+    int checkAllPairs(int n, const std::vector<std::tuple<int, int, int>> &Edges)
+    {
+        graph::directed_graph<int, int> D;
+        build(D, n, Edges);
+        std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, false);
+        std::unordered_map<int, std::unordered_map<int, double>> Distances = D.allPairsShortestDistances();
+        graph::undirected_graph<int, int>::all_pairs_paths Paths = D.allPairsShortestPaths();
+
+        int errors = 0;
+        for(int s = 0; s < n; ++s)
+        {
+            std::vector<double> Expected = referenceBellmanFord(Adj, s);
+            for(int v = 0; v < n; ++v)
+            {
+                errors += Distances[s][v] != Expected[v] || Paths.shortestDistance(s, v) != Expected[v];
+                errors += checkPath(Adj, Paths.shortestPath(s, v), s, v, Expected[v]);
+            }
+        }
+        return errors;
+    }
+
+    // Johnson's algorithm, on sparse graphs with and without negative weights.
+    void testJohnson(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 8; ++trial)
+        {
+            int n = 1 + rng() % 200;
+            errors += checkAllPairs(n, randomEdges(rng, n, 2 * n, trial % 2 ? -1 : 0, 30, false));
+        }
+        report("all pairs: Johnson vs Bellman-Ford", errors);
+    }
+
+    // Blocked Floyd-Warshall, on dense graphs and on sparse graphs with a negative cycle(Johnson hands them over). The graphs span several
+    // 64 x 64 tiles.
+    void testFloydWarshall(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 8; ++trial)
+        {
+            int n = 64 + rng() % 100;
+            std::vector<std::tuple<int, int, int>> Edges;
+            if(trial % 2)
+            {
+                Edges = randomEdges(rng, n, 2 * n, -1, 30, false);
+                Edges.push_back(std::make_tuple(n - 2, n - 1, -5));
+                Edges.push_back(std::make_tuple(n - 1, n - 2, 1));
+            }
+            else
+                Edges = randomEdges(rng, n, n * n / 3, 0, 30, false);
+            errors += checkAllPairs(n, Edges);
+        }
+        report("all pairs: Floyd-Warshall vs Bellman-Ford", errors);
+    }
+
+    std::string readFile(const char *name)
+    {
+        std::ifstream In(name, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(In), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const char *name, const std::string &Bytes)
+    {
+        std::ofstream(name, std::ios::binary).write(Bytes.data(), Bytes.size());
+    }
+
+    // all_pairs_paths written by save and read back by load, with integral and string labels. A file that is truncated, has a bad header
+    // or a vertex count larger than the file, or next vertices that leave the table or loop, must be refused and keep the table.
+    void testAllPairsFile(std::mt19937 &rng)
+    {
+        const char *file = "test_all_pairs.bin";
+        int errors = 0;
+        for(int trial = 0; trial < 10; ++trial)
+        {
+            int n = 2 + rng() % 80;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, 3 * n, trial % 2 ? -1 : 0, 30, false);
+            graph::directed_graph<int, int> D;
+            graph::directed_graph<std::string, int> S;
+            build(D, n, Edges);
+            for(int v = 0; v < n; ++v)
+                S.addVertex(std::to_string(v));
+            for(const std::tuple<int, int, int> &e : Edges)
+                S.addEdge(std::to_string(std::get<0>(e)), std::to_string(std::get<1>(e)), std::get<2>(e));
+
+            graph::undirected_graph<int, int>::all_pairs_paths Paths = D.allPairsShortestPaths(), Loaded;
+            graph::undirected_graph<std::string, int>::all_pairs_paths Strings, LoadedStrings;
+            Strings = S.allPairsShortestPaths();
+            errors += !Paths.save(file) || !Loaded.load(file) || Loaded.size() != Paths.size();
+            std::string Bytes = readFile(file);
+            errors += !Strings.save(file) || !LoadedStrings.load(file) || LoadedStrings.size() != Strings.size();
+            for(int s = 0; s < n; ++s)
+                for(int v = 0; v < n; ++v)
+                {
+                    std::vector<std::string> Path;
+                    for(int w : Paths.shortestPath(s, v))
+                        Path.push_back(std::to_string(w));
+                    errors += Loaded.shortestDistance(s, v) != Paths.shortestDistance(s, v) || Loaded.shortestPath(s, v) != Paths.shortestPath(s, v);
+                    errors += LoadedStrings.shortestDistance(std::to_string(s), std::to_string(v)) != Paths.shortestDistance(s, v);
+                    errors += LoadedStrings.shortestPath(std::to_string(s), std::to_string(v)) != Path;
+                }
+
+            // The next vertex matrix ends the file, one 32-bit row after the other.
+            std::size_t next = Bytes.size() - 4 * n * n;
+            std::uint32_t outside = n + 5, self = 0;
+            std::vector<std::string> Corrupt(5, Bytes);
+            Corrupt[0].resize(rng() % Bytes.size());
+            Corrupt[1][0] = 'X';
+            std::memset(&Corrupt[2][4], 0x7f, 8);
+            std::memcpy(&Corrupt[3][next + 4], &outside, 4);
+            std::memcpy(&Corrupt[4][next + 4], &self, 4);
+            for(const std::string &Bad : Corrupt)
+            {
+                writeFile(file, Bad);
+                errors += Loaded.load(file) || Loaded.size() != Paths.size() || Loaded.shortestDistance(0, 1) != Paths.shortestDistance(0, 1);
+            }
+        }
+        std::remove(file);
+        report("all pairs table: save and load", errors);
+    }
+
+    // shortest_path_tree: distances and paths against Bellman-Ford, path ranges(walked from the destination back) against the paths,
+    // and subtrees against the paths(a vertex is in the subtree of another if and only if its path passes through the other). Also built
+    // for string labels.
+    void testShortestPathTree(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 15; ++trial)
+        {
+            int n = 1 + rng() % 150;
+            bool undirected = trial % 2;
+            int kind = trial % 3;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (3 * n), kind == 2 && !undirected ? -1 : (kind == 0), kind == 0 ? 1 : 20, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+            std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, undirected);
+
+            int source = rng() % n;
+            std::vector<double> Expected = referenceBellmanFord(Adj, source);
+            graph::undirected_graph<int, int>::shortest_path_tree Tree = G.singleSourceShortestPaths(source);
+            errors += Tree.source() != source;
+            std::vector<std::vector<int>> Paths(n);
+            for(int v = 0; v < n; ++v)
+            {
+                Paths[v] = Tree.shortestPath(v);
+                std::vector<int> Range;
+                for(int w : Tree.pathRange(v))
+                    Range.insert(Range.begin(), w);
+                errors += Tree.shortestDistance(v) != Expected[v] || Range != Paths[v];
+                errors += checkPath(Adj, Paths[v], source, v, Expected[v]);
+            }
+
+            for(int u = 0; u < n; ++u)
+            {
+                if(Expected[u] == inf || Expected[u] == -inf)
+                    continue;
+                std::vector<int> Subtree = Tree.subtree(u);
+                std::vector<bool> InSubtree(n, false);
+                for(int v : Subtree)
+                    InSubtree[v] = true;
+                errors += Tree.subtreeSize(u) != Subtree.size();
+                for(int v = 0; v < n; ++v)
+                {
+                    if(Expected[v] == inf || Expected[v] == -inf)
+                        continue;
+                    bool expected = std::find(Paths[v].begin(), Paths[v].end(), u) != Paths[v].end();
+                    errors += InSubtree[v] != expected || Tree.inSubtree(u, v) != expected;
+                }
+            }
+        }
+
+        graph::undirected_graph<std::string, int> S;
+        S.addEdge("a", "b", 2);
+        S.addEdge("b", "c", 3);
+        errors += S.singleSourceShortestPaths("a").shortestDistance("c") != 5 || S.singleSourceShortestDistances("a")["c"] != 5;
+        report("shortest path tree vs Bellman-Ford", errors);
+    }
+
+    // Direction-optimizing BFS(single source and bidirectional), against a plain queue.
+    void testBFS(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 2 + rng() % 2000;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (8 * n), 1, 1, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            if(trial % 2)
+            {
+                D.freeze();
+                U.freeze();
+            }
+
+            for(int k = 0; k < 4; ++k)
+            {
+                int source = rng() % n;
+                for(bool undirected : {false, true})
+                {
+                    std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, undirected);
+                    std::vector<double> Expected = referenceBFS(Adj, source);
+                    graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+                    std::unordered_map<int, double> Distances = G.singleSourceShortestDistances(source);
+                    graph::undirected_graph<int, int>::shortest_path_tree Tree = G.singleSourceShortestPaths(source);
+                    for(int v = 0; v < n; ++v)
+                    {
+                        errors += Distances[v] != Expected[v] || Tree.shortestDistance(v) != Expected[v];
+                        errors += checkPath(Adj, Tree.shortestPath(v), source, v, Expected[v]);
+                    }
+                    for(int q = 0; q < 10; ++q)
+                    {
+                        int destination = rng() % n;
+                        errors += G.shortestDistance(source, destination) != Expected[destination];
+                        errors += checkPath(Adj, G.shortestPath(source, destination), source, destination, Expected[destination]);
+                    }
+                }
+            }
+        }
+        report("BFS: direction-optimizing vs queue", errors);
+    }
+
+    // Parallel level-synchronous BFS against a plain queue, and parallel connected components against one thread.
+    void testParallelBFS(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 2 + rng() % 2000;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (8 * n), 1, 1, false);
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Edges);
+            build(U, n, Edges);
+            if(trial % 2)
+            {
+                D.freeze();
+                U.freeze();
+            }
+
+            for(int k = 0; k < 4; ++k)
+            {
+                int source = rng() % n;
+                for(bool undirected : {false, true})
+                {
+                    std::vector<double> Expected = referenceBFS(adjacency(n, Edges, undirected), source);
+                    graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+                    std::unordered_map<int, double> Distances = G.singleSourceShortestDistances(source, 0.0, 4);
+                    graph::undirected_graph<int, int>::shortest_path_tree Tree = G.singleSourceShortestPaths(source, 4);
+                    for(int v = 0; v < n; ++v)
+                    {
+                        errors += Distances[v] != Expected[v] || Tree.shortestDistance(v) != Expected[v];
+                        if(Expected[v] != inf)
+                            errors += Tree.shortestPath(v).size() != Expected[v] + 1;
+                    }
+                }
+            }
+
+            std::vector<std::vector<int>> A = U.connectedComponents(1), B = U.connectedComponents(4);
+            std::vector<int> ComponentA(n), ComponentB(n);
+            errors += componentOf(A, ComponentA) + componentOf(B, ComponentB);
+            errors += ComponentA != ComponentB;
+        }
+        report("BFS: parallel vs queue", errors);
+    }
+
+    // Multi-source bit-parallel BFS: unweighted all pairs(the sources take several batches of 256), eccentricity and closeness.
+    void testMultiSourceBFS(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 4; ++trial)
+        {
+            int n = 200 + rng() % 400;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, 2 * n, 1, 1, false);
+            errors += checkAllPairs(n, Edges);
+
+            graph::directed_graph<int, int> D;
+            build(D, n, Edges);
+            std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, false);
+            for(unsigned int threads : {1u, 4u})
+            {
+                std::unordered_map<int, double> Eccentricity = D.eccentricity(threads), Closeness = D.closenessCentrality(threads);
+                for(int s = 0; s < n; ++s)
+                {
+                    std::vector<double> Distance = referenceBFS(Adj, s);
+                    double farthest = 0, total = 0, reached = 0;
+                    for(int v = 0; v < n; ++v)
+                        if(v != s && Distance[v] != inf)
+                        {
+                            farthest = std::max(farthest, Distance[v]);
+                            total += Distance[v];
+                            reached += 1;
+                        }
+                    double closeness = reached == 0 ? 0 : (reached / total) * (reached / (n - 1));
+                    errors += Eccentricity[s] != farthest || std::abs(Closeness[s] - closeness) > 1e-12;
+                }
+            }
+        }
+        report("all pairs: multi-source BFS vs BFS", errors);
+    }
+
+    // The iterative DFS engine: cycle detection against peeling sources/leaves, cut vertices and cut edges against removing each one and
+    // counting the components, and a path deep enough to overflow a recursive search.
+    void testDFS(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 200; ++trial)
+        {
+            int n = 1 + rng() % 40;
+            std::vector<std::pair<int, int>> Edges = simpleEdges(rng, n, rng() % (2 * n), true);
+            graph::undirected_graph<int, int> U;
+            build(U, n, Edges);
+
+            std::vector<int> ExpectedVertices, CutVertices = U.cutVertices();
+            std::vector<std::pair<int, int>> ExpectedBridges, Bridges;
+            referenceCuts(n, Edges, ExpectedVertices, ExpectedBridges);
+            for(const std::pair<int, int> &e : U.cutEdges())
+                Bridges.push_back(ordered(e.first, e.second));
+            std::sort(CutVertices.begin(), CutVertices.end());
+            std::sort(Bridges.begin(), Bridges.end());
+            errors += CutVertices != ExpectedVertices || Bridges != ExpectedBridges;
+
+            // A forest has one edge less than vertices per tree.
+            int components = countComponents(referenceComponents(n, Edges));
+            errors += U.isCyclic() != (static_cast<int>(Edges.size()) > n - components);
+
+            // A directed graph is acyclic if and only if repeatedly removing the vertices without in-edges removes all of them.
+            std::vector<std::pair<int, int>> Arcs = simpleEdges(rng, n, rng() % (2 * n), false);
+            graph::directed_graph<int, int> D;
+            build(D, n, Arcs);
+            std::vector<int> InDegree(n, 0), Sources;
+            std::vector<std::vector<int>> Out(n);
+            for(const std::pair<int, int> &e : Arcs)
+            {
+                Out[e.first].push_back(e.second);
+                InDegree[e.second]++;
+            }
+            for(int v = 0; v < n; ++v)
+                if(InDegree[v] == 0)
+                    Sources.push_back(v);
+            for(std::size_t i = 0; i < Sources.size(); ++i)
+                for(int w : Out[Sources[i]])
+                    if(--InDegree[w] == 0)
+                        Sources.push_back(w);
+            errors += D.isCyclic() != (static_cast<int>(Sources.size()) < n);
+        }
+
+        int n = 100000;
+        std::vector<std::pair<int, int>> Path;
+        for(int v = 0; v + 1 < n; ++v)
+            Path.push_back(std::make_pair(v, v + 1));
+        graph::undirected_graph<int, int> U;
+        graph::directed_graph<int, int> D;
+        build(U, n, Path);
+        build(D, n, Path);
+        errors += U.cutVertices().size() != static_cast<std::size_t>(n - 2) || U.cutEdges().size() != static_cast<std::size_t>(n - 1) || U.isCyclic();
+        errors += D.isCyclic();
+        D.addEdge(n - 1, 0);
+        errors += !D.isCyclic();
+        report("DFS: cycles, cut vertices and cut edges vs brute force", errors);
+    }
+
+    // biconnectedComponents against brute force: the cut vertices and bridges by removal, every block biconnected(or a bridge, or an
+    // isolated vertex), two blocks sharing at most a cut vertex, and the 2-edge-connected components those of the graph without bridges.
+    void testBiconnectedComponents(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 200; ++trial)
+        {
+            int n = 1 + rng() % 30;
+            std::vector<std::pair<int, int>> Edges = simpleEdges(rng, n, rng() % (2 * n), true);
+            graph::undirected_graph<int, int> U;
+            build(U, n, Edges);
+            graph::undirected_graph<int, int>::biconnected_components B = U.biconnectedComponents();
+
+            std::vector<int> ExpectedVertices, CutVertices = B.cutVertices();
+            std::vector<std::pair<int, int>> ExpectedBridges, Bridges;
+            referenceCuts(n, Edges, ExpectedVertices, ExpectedBridges);
+            for(const std::pair<int, int> &e : B.bridges())
+                Bridges.push_back(ordered(e.first, e.second));
+            std::sort(CutVertices.begin(), CutVertices.end());
+            std::sort(Bridges.begin(), Bridges.end());
+            errors += CutVertices != ExpectedVertices || Bridges != ExpectedBridges;
+
+            std::vector<bool> Cut(n, false);
+            for(int v : ExpectedVertices)
+                Cut[v] = true;
+            std::vector<std::vector<int>> Blocks = B.blocks();
+            std::vector<std::vector<std::size_t>> BlocksOf(n);
+            std::vector<std::vector<bool>> InBlock(Blocks.size(), std::vector<bool>(n, false));
+            for(std::size_t b = 0; b < Blocks.size(); ++b)
+                for(int v : Blocks[b])
+                {
+                    BlocksOf[v].push_back(b);
+                    InBlock[b][v] = true;
+                }
+            for(int v = 0; v < n; ++v)
+            {
+                std::vector<std::size_t> Listed = B.blocksOf(v);
+                std::sort(Listed.begin(), Listed.end());
+                errors += Listed != BlocksOf[v] || BlocksOf[v].empty() || (BlocksOf[v].size() > 1) != Cut[v] || B.isCutVertex(v) != Cut[v];
+            }
+
+            // Every edge lies in exactly one block.
+            for(const std::pair<int, int> &e : Edges)
+            {
+                int count = 0;
+                for(std::size_t b = 0; b < Blocks.size(); ++b)
+                    count += InBlock[b][e.first] && InBlock[b][e.second];
+                errors += count != 1;
+            }
+
+            for(std::size_t b = 0; b < Blocks.size(); ++b)
+            {
+                // Two vertices must be a bridge, more must stay connected without any one of them.
+                std::vector<std::pair<int, int>> Inner;
+                for(const std::pair<int, int> &e : Edges)
+                    if(InBlock[b][e.first] && InBlock[b][e.second])
+                        Inner.push_back(e);
+                if(Blocks[b].size() == 2)
+                    errors += !std::binary_search(ExpectedBridges.begin(), ExpectedBridges.end(), ordered(Blocks[b][0], Blocks[b][1]));
+                for(int skip = -1; skip < static_cast<int>(Blocks[b].size()) && Blocks[b].size() > 2; ++skip)
+                {
+                    std::vector<int> Component = referenceComponents(n, Inner, skip < 0 ? -1 : Blocks[b][skip]);
+                    int root = Blocks[b][skip == 0];
+                    for(int v : Blocks[b])
+                        errors += (skip < 0 || v != Blocks[b][skip]) && Component[v] != Component[root];
+                }
+                for(std::size_t c = b + 1; c < Blocks.size(); ++c)
+                {
+                    int shared = 0;
+                    for(int v : Blocks[c])
+                        shared += InBlock[b][v];
+                    errors += shared > 1;
+                }
+            }
+
+            std::size_t treeEdges = 0;
+            for(int v : ExpectedVertices)
+                treeEdges += BlocksOf[v].size();
+            std::vector<std::pair<std::size_t, int>> Tree = B.blockCutTree();
+            errors += Tree.size() != treeEdges;
+            for(const std::pair<std::size_t, int> &e : Tree)
+                errors += e.first >= Blocks.size() || !Cut[e.second] || !InBlock[e.first][e.second];
+
+            std::vector<std::pair<int, int>> Kept;
+            for(const std::pair<int, int> &e : Edges)
+                if(!std::binary_search(ExpectedBridges.begin(), ExpectedBridges.end(), ordered(e.first, e.second)))
+                    Kept.push_back(e);
+            std::vector<int> Expected = referenceComponents(n, Kept), Component(n);
+            errors += componentOf(B.twoEdgeConnectedComponents(), Component);
+            errors += Component != Expected;
+            for(int a = 0; a < n; ++a)
+                for(int c = 0; c < n; ++c)
+                    errors += B.twoEdgeConnected(a, c) != (Expected[a] == Expected[c]);
+        }
+        report("biconnected components vs brute force", errors);
+    }
+
+    // Trim, forward-backward and coloring, against mutual reachability.
+    void testSCC(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 60; ++trial)
+        {
+            int n = 1 + rng() % 300;
+            int edges = rng() % (3 * n);
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, edges, 1, 1, trial % 5 == 0);
+
+            // Chains of 2-cycles and a long cycle, the worst cases for coloring and forward-backward.
+            if(trial % 3 == 0)
+                for(int v = 0; v + 1 < n; ++v)
+                {
+                    Edges.push_back(std::make_tuple(v + 1, v, 1));
+                    if(v % 2 == 0)
+                        Edges.push_back(std::make_tuple(v, v + 1, 1));
+                }
+            if(trial % 3 == 1)
+                for(int v = 0; v < n; ++v)
+                    Edges.push_back(std::make_tuple(v, (v + 1) % n, 1));
+
+            graph::directed_graph<int, int> D;
+            build(D, n, Edges);
+            if(trial % 4 == 0)
+                D.freeze();
+
+            std::vector<int> Expected = referenceSCC(adjacency(n, Edges, false));
+            for(unsigned int threads : {1u, 2u, 4u})
+            {
+                std::vector<int> Component(n);
+                errors += componentOf(D.stronglyConnectedComponents(threads), Component);
+                errors += Component != Expected;
+            }
+        }
+        report("strongly connected components vs reachability", errors);
+    }
+
+    // Searches for a trail that uses every edge once(circuit: one that ends where it starts), from every start vertex.
+    bool findTrail(const std::vector<std::pair<int, int>> &Edges, bool undirected, std::vector<bool> &Used, int at, int start, std::size_t used, bool circuit)
+    {
+        if(used == Edges.size())
+            return !circuit || at == start;
+        for(std::size_t i = 0; i < Edges.size(); ++i)
+        {
+            if(Used[i] || (Edges[i].first != at && !(undirected && Edges[i].second == at)))
+                continue;
+            Used[i] = true;
+            bool found = findTrail(Edges, undirected, Used, Edges[i].first == at ? Edges[i].second : Edges[i].first, start, used + 1, circuit);
+            Used[i] = false;
+            if(found)
+                return true;
+        }
+        return false;
+    }
+
+    // 2 if the edges have an Eulerian circuit, 1 if only an Eulerian path, 0 if neither.
+    int referenceEulerian(int n, const std::vector<std::pair<int, int>> &Edges, bool undirected)
+    {
+        if(Edges.empty())
+            return 2;
+        std::vector<bool> Used(Edges.size(), false);
+        for(bool circuit : {true, false})
+            for(int start = 0; start < n; ++start)
+                if(findTrail(Edges, undirected, Used, start, start, 0, circuit))
+                    return circuit ? 2 : 1;
+        return 0;
+    }
+
+    // The path must use every edge exactly once(any of the parallel ones between two vertices), and close if the graph is Eulerian.
+    int checkEulerianPath(const std::vector<int> &Path, std::vector<std::pair<int, int>> Edges, bool undirected, int expected)
+    {
+        if(expected == 0)
+            return !Path.empty();
+        if(Path.size() != Edges.size() + 1 || (expected == 2 && Path.front() != Path.back()))
+            return 1;
+        for(std::size_t i = 0; i + 1 < Path.size(); ++i)
+        {
+            std::vector<std::pair<int, int>>::iterator it = std::find(Edges.begin(), Edges.end(), std::make_pair(Path[i], Path[i + 1]));
+            if(it == Edges.end() && undirected)
+                it = std::find(Edges.begin(), Edges.end(), std::make_pair(Path[i + 1], Path[i]));
+            if(it == Edges.end())
+                return 1;
+            Edges.erase(it);
+        }
+        return 0;
+    }
+
+    // Hierholzer's algorithm: isEulerian against a search over all trails on small multigraphs(parallel edges have different weights,
+    // self loops included, frozen or not), eulerianPath on those and on long random closed walks, with and without one edge more.
+    void testEulerian(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 400; ++trial)
+        {
+            int n = 1 + rng() % 6;
+            bool undirected = trial % 2;
+            std::set<std::tuple<int, int, int>> Seen;
+            std::vector<std::pair<int, int>> Edges;
+            std::vector<std::tuple<int, int, int>> Weighted;
+            for(int i = 0, edges = rng() % 9; i < edges; ++i)
+            {
+                int a = rng() % n, b = rng() % n, w = 1 + rng() % 2;
+                if(undirected && a > b)
+                    std::swap(a, b);
+                if(!Seen.insert(std::make_tuple(a, b, w)).second)
+                    continue;
+                Edges.push_back(std::make_pair(a, b));
+                Weighted.push_back(std::make_tuple(a, b, w));
+            }
+            graph::directed_graph<int, int> D;
+            graph::undirected_graph<int, int> U;
+            build(D, n, Weighted);
+            build(U, n, Weighted);
+            graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+            if(trial % 4 >= 2)
+                G.freeze();
+
+            int expected = referenceEulerian(n, Edges, undirected);
+            errors += G.isEulerian() != expected;
+            if(!Edges.empty())
+                errors += checkEulerianPath(G.eulerianPath(), Edges, undirected, expected);
+        }
+
+        for(int trial = 0; trial < 8; ++trial)
+        {
+            int n = 2 + rng() % 200;
+            bool undirected = trial % 2;
+            std::vector<std::pair<int, int>> Edges;
+            std::vector<std::tuple<int, int, int>> Weighted;
+            for(int i = 0, at = 0, length = 1 + rng() % 3000; i < length; ++i)
+            {
+                int next = i + 1 == length ? 0 : rng() % n;
+                Edges.push_back(std::make_pair(at, next));
+                Weighted.push_back(std::make_tuple(at, next, i + 1));
+                at = next;
+            }
+            for(int extra = 0; extra < 2; ++extra)
+            {
+                graph::directed_graph<int, int> D;
+                graph::undirected_graph<int, int> U;
+                build(D, n, Weighted);
+                build(U, n, Weighted);
+                graph::undirected_graph<int, int> &G = undirected ? U : static_cast<graph::undirected_graph<int, int>&>(D);
+                errors += G.isEulerian() != 2 - extra;
+                errors += checkEulerianPath(G.eulerianPath(), Edges, undirected, 2 - extra);
+
+                Edges.push_back(std::make_pair(0, 1));
+                Weighted.push_back(std::make_tuple(0, 1, 0));
+            }
+        }
+        report("Eulerian paths vs trail search", errors);
+    }
+
+    // Kahn's sort and the parallel levels, against longest paths over a DAG whose edges go from lower to higher vertices.
+    void testTopologicalLevels(std::mt19937 &rng)
+    {
+        int errors = 0;
+        for(int trial = 0; trial < 20; ++trial)
+        {
+            int n = 1 + rng() % 3000;
+            std::vector<std::tuple<int, int, int>> Edges = randomEdges(rng, n, rng() % (4 * n), 1, 1, true);
+            graph::directed_graph<int, int> D;
+            build(D, n, Edges);
+
+            std::vector<int> Level(n, 0);
+            std::vector<std::vector<std::pair<int, int>>> Adj = adjacency(n, Edges, false);
+            for(int v = 0; v < n; ++v)
+                for(const std::pair<int, int> &e : Adj[v])
+                    Level[e.first] = std::max(Level[e.first], Level[v] + 1);
+
+            std::vector<int> Order = D.topologicalSort();
+            std::vector<int> Position(n, -1);
+            for(std::size_t i = 0; i < Order.size(); ++i)
+                Position[Order[i]] = i;
+            errors += Order.size() != static_cast<std::size_t>(n);
+            for(const std::tuple<int, int, int> &e : Edges)
+                errors += Position[std::get<0>(e)] >= Position[std::get<1>(e)];
+
+            for(unsigned int threads : {1u, 4u})
+            {
+                std::vector<std::vector<int>> Levels = D.topologicalLevels(threads);
+                std::size_t listed = 0;
+                for(std::size_t l = 0; l < Levels.size(); ++l)
+                {
+                    listed += Levels[l].size();
+                    for(int v : Levels[l])
+                        errors += Level[v] != static_cast<int>(l);
+                }
+                errors += listed != static_cast<std::size_t>(n);
+            }
+
+            // One edge back makes it cyclic.
+            if(!Edges.empty())
+            {
+                D.addEdge(std::get<1>(Edges[0]), std::get<0>(Edges[0]));
+                errors += !D.topologicalSort().empty() || !D.topologicalLevels(4).empty();
+            }
+        }
+        report("topological sort and levels vs longest paths", errors);
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(2024);
+    testLoadEdges(rng);
+    testDijkstra(rng);
+    testBucketQueues(rng);
+    testAStar(rng);
+    testBidirectionalDijkstra(rng);
+    testContractionHierarchy(rng);
+    testDeltaStepping(rng);
+    testBellmanFord(rng);
+    testJohnson(rng);
+    testFloydWarshall(rng);
+    testAllPairsFile(rng);
+    testShortestPathTree(rng);
+    testBFS(rng);
+    testParallelBFS(rng);
+    testMultiSourceBFS(rng);
+    testDFS(rng);
+    testBiconnectedComponents(rng);
+    testSCC(rng);
+    testEulerian(rng);
+    testTopologicalLevels(rng);
+    return failures == 0 ? 0 : 1;
+}
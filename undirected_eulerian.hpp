@@ -9,18 +9,17 @@ namespace graph
     int undirected_graph<T, W>::isEulerian() const
     {
         // Empty graph is Eulerian.
-        if(this->_ADJACENCY_LIST_.empty())
+        if(this->empty())
             return 2;
 
         // STEP-1: Check if all non-zero degree vertices are connected.
-        unsigned int start;
+        unsigned int start = 0;
         unsigned int numOfEdges = 0;
-        std::unordered_set<unsigned int> Visited;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            if(adj_list.second.size() > 0)
-                start = adj_list.first;
-            numOfEdges += adj_list.second.size();
+            if(this->adjacent(id).size() > 0)
+                start = id;
+            numOfEdges += this->adjacent(id).size();
         }
         numOfEdges /= 2;
 
@@ -28,19 +27,25 @@ namespace graph
         if(numOfEdges == 0)
             return 2;
 
-        isEulerianUtil(start, Visited);
+        dfs_stack Stack(this->_id_);
+        this->depthFirstSearch(Stack, start, false, [](unsigned int, unsigned int) {}, [](unsigned int, unsigned int) { return false; }, [](unsigned int, unsigned int) {});
 
         // If any vertex is unvisited now, it is not connected => not Eulerian.
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
-            if(Visited.find(adj_list.first) == Visited.end() && adj_list.second.size() > 0)
+        for(unsigned int id = 1; id < this->_id_; ++id)
+            if(!Stack.Visited[id] && this->adjacent(id).size() > 0)
                 return 0;
 
 
-        // STEP-2: Find the number of odd-degree vertices.
+        // STEP-2: Find the number of odd-degree vertices. A self loop is kept once in the list, but adds 2 to the degree.
         int oddVertices = 0;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &vertex : this->_ADJACENCY_LIST_)
-            if(vertex.second.size() & 1)
+        for(unsigned int id = 1; id < this->_id_; ++id)
+        {
+            std::size_t degree = this->adjacent(id).size();
+            for(const Node<W> &node : this->adjacent(id))
+                degree += node.vertex == id;
+            if(degree & 1)
                 oddVertices++;
+        }
         
         // If oddVertices > 2 then is not Eulerian.
         if(oddVertices > 2)
@@ -50,51 +55,37 @@ namespace graph
         return (oddVertices == 2) ? 1 : 2;
     }
 
-    template<typename T, typename W>
-    void undirected_graph<T, W>::isEulerianUtil(unsigned int current, std::unordered_set<unsigned int> &Visited) const
-    {
-        // DFS.
-        Visited.insert(current);
-
-        for(const Node<W> &node: this->_ADJACENCY_LIST_.at(current))
-            if(Visited.find(node.vertex) == Visited.end())
-                isEulerianUtil(node.vertex, Visited);
-    }
-
     template<typename T, typename W>
     std::vector<T> undirected_graph<T, W>::eulerianPath() const
     {
         // Empty Eulerian Path for empty graph.
-        if(this->_ADJACENCY_LIST_.empty())
+        if(this->empty())
             return std::vector<T>();
 
-        bool startFound = false;
-        unsigned int numOfEdges = 0;
+        // Finding the number of edges and the start node: an odd degree vertex if there is one, else a vertex with an edge.
+        // A self loop is kept once in the list, but adds 2 to the degree.
+        std::size_t numOfEdges = 0;
         unsigned int oddVertices = 0;
-        unsigned int start = (this->_ADJACENCY_LIST_.begin())->first;
-        std::unordered_map<unsigned int, unsigned int> Degree;
-
-        // Finding the degree of all the vertices. Also finding the appropriate start node.
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &adj_list : this->_ADJACENCY_LIST_)
+        unsigned int start = 0;
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            unsigned int node = adj_list.first;
-            unsigned int size = adj_list.second.size();
-            Degree[node] = size;
-            numOfEdges += size;
+            if(!this->isVertex(id))
+                continue;
 
-            // If there are no odd degree vertices, this selects the start node with non-zero degree.
-            if(startFound == false && size > 0)
-                startFound = node;
+            std::size_t degree = this->adjacent(id).size();
+            for(const Node<W> &node : this->adjacent(id))
+                degree += node.vertex == id;
+            numOfEdges += degree;
 
-            // If the degree is odd.
-            if(Degree[node] & 1)
+            if(start == 0 && degree > 0)
+                start = id;
+            if(degree & 1)
             {
                 oddVertices++;
-                startFound = true;
-                start = node;
+                start = id;
             }
         }
-        // Each edge is present two times in adjacency list. So halve it.
+        // Each edge adds 2 to the sum of the degrees. So halve it.
         numOfEdges /= 2;
 
 
@@ -103,10 +94,9 @@ namespace graph
             return std::vector<T>();
 
 
-        // Find Eulerian Path using DFS from 'start'.
+        // Find Eulerian Path using Hierholzer's algorithm from 'start'.
         std::vector<T> Path;
-        std::unordered_map<unsigned int, std::vector<Node<W>>> _ADJ_LIST_COPY_ = this->_ADJACENCY_LIST_;
-        eulerianPathUtil(start, _ADJ_LIST_COPY_, Degree, Path);
+        eulerianPathUtil(start, Path);
 
         // If all non-zero degree vertices are connected then Eulerian Path is found, else return empty path.
         if(Path.size() != numOfEdges + 1)
@@ -115,29 +105,66 @@ namespace graph
         return Path;
     }
 
+    // Hierholzer's algorithm with an explicit stack: walk unused edges until stuck, then back up one vertex and add it to the path.
+    // Every edge is kept in the lists of both its ends, so the edges are numbered instead of copied: the i-th edge in the list of u is
+    // half-edge Offsets[u] + i, Twin maps it to the copy of the same edge in the list of the other end, and a bit per half-edge marks it used.
     template<typename T, typename W>
-    void undirected_graph<T, W>::eulerianPathUtil(unsigned int current, std::unordered_map<unsigned int, std::vector<Node<W>>> &_ADJ_LIST_COPY_, std::unordered_map<unsigned int, unsigned int> &Degree, std::vector<T> &Path) const
+    void undirected_graph<T, W>::eulerianPathUtil(unsigned int start, std::vector<T> &Path) const
     {
-        unsigned int &degree = Degree.at(current);
-        unsigned int next_edge;
+        unsigned int n = this->_id_;
+        std::vector<std::size_t> Offsets(n + 1, 0);
+        for(unsigned int id = 1; id < n; ++id)
+            Offsets[id + 1] = Offsets[id] + this->adjacent(id).size();
+        std::size_t halfEdges = Offsets[n];
+
+        // Twins, from two counting sorts. Sorting the half-edges by target(then source) and by source(then target) lists the edges around
+        // every vertex u in the same order of the other end, as x -> u in the first and u -> x in the second. So the half-edges at the same
+        // position in both orders are the two copies of one edge(a self loop, kept once, is its own twin).
+        std::vector<std::size_t> Twin(halfEdges);
+        {
+            std::vector<std::size_t> ByTarget(halfEdges);
+            std::vector<unsigned int> Source(halfEdges);
+            std::vector<std::size_t> Fill(Offsets.begin(), Offsets.end() - 1);
+            for(unsigned int id = 1; id < n; ++id)
+            {
+                edge_range<W> Edges = this->adjacent(id);
+                for(std::size_t i = 0; i < Edges.size(); ++i)
+                {
+                    std::size_t position = Fill[Edges[i].vertex]++;
+                    ByTarget[position] = Offsets[id] + i;
+                    Source[position] = id;
+                }
+            }
+
+            std::copy(Offsets.begin(), Offsets.end() - 1, Fill.begin());
+            for(std::size_t position = 0; position < halfEdges; ++position)
+                Twin[ByTarget[position]] = ByTarget[Fill[Source[position]]++];
+        }
 
-        // While the current node still has outgoing edges.
-        while(degree != 0)
+        // The edges of a vertex are used from the back of its list. The cursor skips the edges already used from the other end.
+        std::vector<std::size_t> Cursor(Offsets.begin() + 1, Offsets.end());     // (id - one past its last edge that may be unused) mapping.
+        std::vector<bool> Used(halfEdges, false);
+        std::vector<unsigned int> Stack(1, start);
+        while(!Stack.empty())
         {
-            --degree;
-            // If the edge is already visited, skip that edge.
-            if(_ADJ_LIST_COPY_.at(current).at(degree) == Node<W>{0})
+            unsigned int current = Stack.back();
+            std::size_t &cursor = Cursor[current];
+            while(cursor > Offsets[current] && Used[cursor - 1])
+                --cursor;
+
+            // The current node has no unused edges left: add it to the solution.
+            if(cursor == Offsets[current])
+            {
+                Path.push_back(this->_id_to_node_[current]);
+                Stack.pop_back();
                 continue;
+            }
 
-            // Select the next unvisited edge, mark it visited, continue DFS from that edge.
-            next_edge = _ADJ_LIST_COPY_.at(current).at(degree).vertex;
-            _ADJ_LIST_COPY_.at(current).at(degree) = Node<W>{0};
-            *( std::find(_ADJ_LIST_COPY_.at(next_edge).begin(), _ADJ_LIST_COPY_.at(next_edge).end(), current) ) = Node<W>{0};
-            eulerianPathUtil(next_edge, _ADJ_LIST_COPY_, Degree, Path);
+            // Select the next unused edge, mark both of its copies used, continue from that edge.
+            std::size_t edge = --cursor;
+            Used[edge] = Used[Twin[edge]] = true;
+            Stack.push_back(this->adjacent(current)[edge - Offsets[current]].vertex);
         }
-
-        // Add current node to the solution.
-        Path.push_back(this->_id_to_node_.at(current));
     }
 };
 
@@ -5,11 +5,29 @@
 #include <queue>
 #include <tuple>
 #include <vector>
+#include <limits>
+#include <cmath>
 #include <climits>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include "parallel.hpp"
+#include "search_workspace.hpp"
+#include "dense_matrix.hpp"
+#include "bfs_frontier.hpp"
+#include "dfs_stack.hpp"
+#include "bucket_queue.hpp"
+
+// Sizes from which the parallel engines take over. They can be lowered at compile time, e.g. by test.cpp, to run the parallel code on small graphs.
+#ifndef GRAPH_PARALLEL_BFS_THRESHOLD
+#define GRAPH_PARALLEL_BFS_THRESHOLD 4096
+#endif
+#ifndef GRAPH_PARALLEL_SCC_THRESHOLD
+#define GRAPH_PARALLEL_SCC_THRESHOLD 16384
+#endif
 
 namespace graph
 {
@@ -41,19 +59,156 @@ namespace graph
             }
     };
 
+    // Read-only view over a contiguous run of edges. Both the adjacency vectors and the CSR snapshot hand these out.
+    template<typename W = int>
+    class edge_range
+    {
+        public:
+            const Node<W> *first;
+            const Node<W> *last;
+
+            edge_range() : first (nullptr), last (nullptr)
+            {
+            }
+            edge_range(const Node<W> *f, const Node<W> *l) : first (f), last (l)
+            {
+            }
+
+            const Node<W>* begin() const
+            {
+                return first;
+            }
+            const Node<W>* end() const
+            {
+                return last;
+            }
+            std::size_t size() const
+            {
+                return last - first;
+            }
+            bool empty() const
+            {
+                return first == last;
+            }
+            const Node<W>& operator[](std::size_t i) const
+            {
+                return first[i];
+            }
+    };
+
+    // Compressed-sparse-row snapshot of an adjacency list. The edges of vertex 'id' are Edges[Offsets[id], Offsets[id + 1]).
+    template<typename W = int>
+    class csr_adjacency
+    {
+        public:
+            std::vector<std::size_t> Offsets;
+            std::vector<Node<W>> Edges;
+            W MaxWeight{0};     // Largest edge weight(0 if there are no edges).
+
+            // Given the id-indexed adjacency list, lays out all the edges contiguously in id order.
+            void build(const std::vector<std::vector<Node<W>>> &adjacency)
+            {
+                std::size_t idLimit = adjacency.size();
+                Offsets.assign(idLimit + 1, 0);
+                for(std::size_t id = 0; id < idLimit; ++id)
+                    Offsets[id + 1] = Offsets[id] + adjacency[id].size();
+
+                Edges.clear();
+                Edges.reserve(Offsets[idLimit]);
+                for(const std::vector<Node<W>> &edges : adjacency)
+                    Edges.insert(Edges.end(), edges.begin(), edges.end());
+
+                MaxWeight = 0;
+                for(const Node<W> &node : Edges)
+                    if(MaxWeight < node.weight)
+                        MaxWeight = node.weight;
+            }
+
+            void clear()
+            {
+                Offsets.clear();
+                Edges.clear();
+                Offsets.shrink_to_fit();
+                Edges.shrink_to_fit();
+                MaxWeight = 0;
+            }
+
+            edge_range<W> neighbours(unsigned int id) const
+            {
+                return edge_range<W>(Edges.data() + Offsets[id], Edges.data() + Offsets[id + 1]);
+            }
+    };
+
     template<typename T, typename W = int>
     class undirected_graph
     {   
         protected:
-            std::unordered_map<unsigned int, std::vector<Node<W>>> _ADJACENCY_LIST_;
-            std::unordered_map<unsigned int, T> _id_to_node_;
+            // Ids are handed out sequentially, so the per-vertex data is stored in vectors indexed by id.
+            // Removed vertices leave a tombstone(_alive_[id] = false, empty adjacency list) behind.
+            std::vector<std::vector<Node<W>>> _ADJACENCY_LIST_;
+            std::vector<T> _id_to_node_;
+            std::vector<bool> _alive_;
             std::unordered_map<T, unsigned int> _node_to_id_;
             bool isNegWeighted{false};
             bool isWeighted{false};
             unsigned int _id_{1};       // 0 can be used as sentinel.
 
+            // CSR snapshot of _ADJACENCY_LIST_. Valid only while the graph is frozen.
+            csr_adjacency<W> _CSR_;
+            bool _frozen_{false};
+
+            // Hash index(target id -> weight) over the adjacency list of every vertex whose degree has reached _INDEX_THRESHOLD_.
+            // Duplicate-edge checks use it instead of a linear scan, so loading high-degree vertices is not quadratic.
+            std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>> _NEIGHBOUR_INDEX_;
+            static constexpr std::size_t _INDEX_THRESHOLD_ = 32;
+
+            // Dijkstra keeps integral distances for integral weights and runs them through a monotone bucket queue:
+            // Dial's buckets when the graph is frozen and its largest weight is at most _DIAL_MAX_WEIGHT_, a radix heap otherwise.
+            typedef typename std::conditional<std::is_integral<W>::value, unsigned long long, double>::type distance_type;
+            static constexpr unsigned long long _DIAL_MAX_WEIGHT_ = 4096;
+
+            // Smallest BFS level worth handing to a team of threads. Smaller levels are cheaper to expand than to split.
+            static constexpr std::size_t _PARALLEL_BFS_THRESHOLD_ = GRAPH_PARALLEL_BFS_THRESHOLD;
+
             // Function to check whether the graph is still weighted/negative Weighted.
             void checkGraph();
+            // Given an object, returns its id. The object is added to the graph first, if it doesn't exist already.
+            virtual unsigned int insertVertex(const T &);
+            // Returns true if the id belongs to a vertex of the graph(i.e. it is neither the sentinel nor a tombstone).
+            bool isVertex(unsigned int) const;
+            // Given an id, removes the vertex and its edges, leaving a tombstone in its place.
+            virtual void eraseVertex(unsigned int);
+            // Returns the outgoing edges of a vertex. Reads from the CSR snapshot when the graph is frozen.
+            edge_range<W> adjacent(unsigned int) const;
+            // Returns the incoming edges of a vertex. Every edge of an undirected graph is its own reverse, so these are its adjacent edges.
+            virtual edge_range<W> inAdjacent(unsigned int) const;
+            // Returns true if the adjacency list of the first id has an edge to the second id(with any weight).
+            bool hasEdge(unsigned int, unsigned int) const;
+            // Returns true if the adjacency list of the id has the given edge(same target and weight).
+            bool hasEdge(unsigned int, const Node<W> &) const;
+            // Appends the edge to the adjacency list of the id, keeping the neighbour index in sync.
+            void appendEdge(unsigned int, const Node<W> &);
+            // Removes all the edges from the first id to the second id from the adjacency list.
+            void eraseEdges(unsigned int, unsigned int);
+            // Removes the given edge(same target and weight) from the adjacency list of the id.
+            void eraseEdge(unsigned int, const Node<W> &);
+            // Given a list of edges, interns their vertices(serially/with the given number of threads) and returns them as (source id, edge) records.
+            std::vector<std::pair<unsigned int, Node<W>>> internEdges(const std::vector<std::tuple<T, T, W>> &);
+            std::vector<std::pair<unsigned int, Node<W>>> internEdgesParallel(const std::vector<std::tuple<T, T, W>> &, unsigned int);
+            // Given the (source id, edge) records of new edges, writes them to the graph in one sorted pass.
+            virtual void writeEdges(std::vector<std::pair<unsigned int, Node<W>>> &);
+            // Radix sorts the (source id, edge) records by (source, target) and removes the exact duplicates.
+            void sortEdges(std::vector<std::pair<unsigned int, Node<W>>> &) const;
+            // Appends the sorted records to the adjacency lists in a single pass. Records whose edge already exists are dropped from the vector.
+            void appendSortedEdges(std::vector<std::pair<unsigned int, Node<W>>> &);
+            // Returns the in-edge lists that mirror _ADJACENCY_LIST_, if the graph keeps any(used by edge_iterator to keep weights in sync).
+            virtual std::vector<std::vector<Node<W>>>* reverseAdjacencyList();
+            // Iterative DFS from an unvisited root over out-edges, with an explicit frame stack instead of recursion. Calls discover(vertex, parent) when a vertex
+            // is entered, visited(vertex, next) for every edge to an already visited vertex(returning true stops the search) and finish(vertex, parent) once
+            // all the edges of a vertex are done. With undirected = true, the first edge from a vertex back to its parent is the tree edge seen from the
+            // other end, and is skipped. Returns true if visited() stopped the search.
+            template<typename Discover, typename Visited, typename Finish>
+            bool depthFirstSearch(dfs_stack&, unsigned int, bool, Discover, Visited, Finish) const;
         public:
             /*
              *  SPECIAL MEMBER FUNCTIONS
@@ -85,7 +240,7 @@ namespace graph
             // Swaps the internal data structures of the given graphs.
             void swap(undirected_graph &);
             // Clears the container.
-            void clear();
+            virtual void clear();
 
             // Given an object, adds it to the graph, if it doesn't exist already.
             bool addVertex(T);
@@ -97,6 +252,9 @@ namespace graph
             virtual bool addEdges(const std::vector<std::pair<T, T>> &);
             // Given a list of tuple of objects along with weights, adds each edge to the graph, if it doesn't exist already.
             virtual bool addEdges(const std::vector<std::tuple<T, T, W>> &);
+            // Given a (large) list of tuple of objects along with weights, builds all the edges in one sorted pass. Duplicate edges are skipped.
+            // With threads != 1 the vertices are interned by that many worker threads(0 -> one per core).
+            bool loadEdges(const std::vector<std::tuple<T, T, W>> &, unsigned int threads = 1);
             
             // Given an object, removes it and its edges from the graph, if it exists.
             bool removeVertex(T);
@@ -111,6 +269,11 @@ namespace graph
             // Given a list of tuple of vertices and weights, removes each specified edge from the graph, if it exists.
             virtual bool removeEdges(const std::vector<std::tuple<T, T, W>> &);
 
+            // Builds an immutable CSR snapshot of the graph. Until thaw() is called, all the algorithms read the snapshot and the graph cannot be modified.
+            virtual void freeze();
+            // Drops the CSR snapshot and makes the graph modifiable again.
+            virtual void thaw();
+
 
             /*
              *  CONST MEMBER FUNCTIONS
@@ -130,21 +293,49 @@ namespace graph
             double shortestDistance(T, T) const;
             // Given two vertices, returns the shortest path between them.
             std::vector<T> shortestPath(T, T) const;
+            // Given two vertices and an admissible heuristic(h(v) <= true distance from v to the destination), returns the length of shortest path between them found by A*.
+            template<typename Heuristic>
+            double shortestDistance(T, T, Heuristic) const;
+            // Given two vertices and an admissible heuristic(h(v) <= true distance from v to the destination), returns the shortest path between them found by A*.
+            template<typename Heuristic>
+            std::vector<T> shortestPath(T, T, Heuristic) const;
             // Given a vertex, returns the length of shortest paths from it to all other vertices.
-            std::unordered_map<T, double> singleSourceShortestDistances(unsigned int) const;
-            // Given a vertex, returns the shortest path from it to all other vertices.
-            std::unordered_map<T, std::vector<T>> singleSourceShortestPaths(unsigned int) const;
+            std::unordered_map<T, double> singleSourceShortestDistances(T) const;
+            class shortest_path_tree;
+            // Given a vertex, returns the shortest paths from it to all other vertices, as a tree of parents that spells out a path on demand.
+            // On unweighted graphs, large searches are run by the given number of threads(0 -> one per core).
+            shortest_path_tree singleSourceShortestPaths(T, unsigned int threads = 0) const;
+            // Given a vertex, a bucket width(0 -> chosen from the weights) and a number of threads(0 -> one per core), returns the length of
+            // shortest paths from it to all other vertices, computed by parallel delta-stepping.
+            std::unordered_map<T, double> singleSourceShortestDistances(T, double, unsigned int threads = 0) const;
             // Returns the length of shortest paths for all pairs of vertices.
             std::unordered_map<T, std::unordered_map<T, double>> allPairsShortestDistances() const;
-            // Returns the shortest path for all pairs of vertices.
-            std::unordered_map<T, std::unordered_map<T, std::vector<T>>> allPairsShortestPaths() const;
+            class all_pairs_paths;
+            // Returns the shortest paths for all pairs of vertices, as a table of distances and next vertices that spells out a path on demand.
+            all_pairs_paths allPairsShortestPaths() const;
+
+            // Returns the eccentricity of every vertex: the largest distance from it to a vertex it can reach(unreachable vertices are ignored).
+            // Sources are spread across the given number of threads(0 -> one per core). Returns an empty map for negative weighted graphs.
+            std::unordered_map<T, double> eccentricity(unsigned int threads = 0) const;
+            // Returns the closeness centrality of every vertex: (reached / sum of distances to them) * (reached / (V - 1)), where reached is the
+            // number of other vertices it can reach(Wasserman and Faust), 0 if it reaches none. Threads and negative weights as above.
+            std::unordered_map<T, double> closenessCentrality(unsigned int threads = 0) const;
+
+            class contraction_hierarchy;
+            // Builds a contraction hierarchy of the graph: a static index answering point-to-point shortest path queries far faster than a search.
+            // The graph must not be negative weighted(the hierarchy is empty otherwise).
+            contraction_hierarchy contractionHierarchy() const;
 
             // Returns a vector of pairs containing cut edges.
             virtual std::vector<std::pair<T, T>> cutEdges() const;
             // Returns a vector containing cut vertices.
             virtual std::vector<T> cutVertices() const;
+            class biconnected_components;
+            // Returns the blocks(biconnected components), cut vertices, bridges, 2-edge-connected components and block-cut tree of the graph, found in one DFS.
+            biconnected_components biconnectedComponents() const;
             // Returns a vector of vectors, where each vector contains vertices of a connected component.
-            virtual std::vector<std::vector<T>> connectedComponents() const;
+            // Large components are searched by the given number of threads(0 -> one per core).
+            virtual std::vector<std::vector<T>> connectedComponents(unsigned int threads = 0) const;
             // Returns a vector of edges which are a part of a minimum spanning tree. If MST doesn't exist, returns an empty vector.
             virtual std::vector<std::tuple<T, T, W>> minimumSpanningTree() const;
 
@@ -164,6 +355,8 @@ namespace graph
             int degree(T) const;
             // Returns true if the graph is empty, else false. 
             bool empty() const;
+            // Returns true if the graph is frozen, else false.
+            bool isFrozen() const;
             // Utility function to check the (id - node) mapping.
             void printMap() const;
 
@@ -190,27 +383,69 @@ namespace graph
             const_edge_iterator cend(int) const;
 
         private:
-            void printBFSUtil(unsigned int, std::unordered_set<unsigned int> &) const;
-            void printDFSUtil(unsigned int, std::unordered_set<unsigned int> &) const;
-            void cutEdgesUtil(unsigned int, unsigned int, unsigned int &, std::vector<std::pair<T, T>> &, std::unordered_set<unsigned int> &, std::unordered_map<unsigned int, unsigned int> &, std::unordered_map<unsigned int, unsigned int> &) const;
-            void cutVerticesUtil(unsigned int &, std::vector<T> &, std::unordered_set<unsigned int> &, std::unordered_map<unsigned int, unsigned int> &, std::unordered_map<unsigned int, unsigned int> &, unsigned int, unsigned int) const;
-            virtual void eulerianPathUtil(unsigned int, std::unordered_map<unsigned int, std::vector<Node<W>>> &, std::unordered_map<unsigned int, unsigned int> &, std::vector<T> &) const;
-            virtual void isEulerianUtil(unsigned int, std::unordered_set<unsigned int> &) const;
-            bool isCyclicUtil(unsigned int, std::unordered_set<unsigned int> &, unsigned int) const;
+            void printBFSUtil(unsigned int, search_workspace<double> &, bfs_frontier &) const;
+            // Hierholzer's algorithm from the given vertex. Appends the vertices of the path, in reverse order, to the vector.
+            virtual void eulerianPathUtil(unsigned int, std::vector<T> &) const;
 
             /*
              *  SHORTEST PATH RELATED FUNCTIONS
-             *  If two valid vertices are given, returns (bestDistancesMap, bestPathsMap) tuple,
-             *  except for bidirectionalSearch which returns (bestDistance, bestPath) tuple.
+             *  Dijkstra, bellmanFord and breadthFirstSearch fill the given workspace with the (bestDistance, parent) of every vertex reached from the source.
+             *  bidirectionalDijkstra fills a forward and a backward workspace, which meet at the returned id.
+             *  bidirectionalSearch fills a forward and a backward workspace like bidirectionalDijkstra. floydWarshall and johnson fill the dense (distance, next vertex) matrices, indexed by position in the given ids.
              *  Use Bellman-Ford for negative weighted graphs, Bidirectional Search/BFS for unweighted graphs, Dijkstra for others.
+             *  Bidirectional Dijkstra for weighted point-to-point queries, delta-stepping for parallel SSSP, A* when the caller supplies a heuristic(and the graph has no negative weights).
              *  BFS for SSSP, Bidirectional Search for when both source and destination are given.
              */
-            // To disable early stopping(for SSSP problem), call this function without second parameter.
-            std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>> Dijkstra(unsigned int, unsigned int = 0) const;
-            std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>> bellmanFord(unsigned int) const;
-            std::tuple<std::unordered_map<unsigned int, double>, std::unordered_map<unsigned int, unsigned int>> breadthFirstSearch(unsigned int) const;
-            std::tuple<double, std::vector<T>> bidirectionalSearch(unsigned int, unsigned int) const;
-            std::tuple<std::unordered_map<unsigned int, std::unordered_map<unsigned int, double>>, std::unordered_map<unsigned int, std::unordered_map<unsigned int, unsigned int>>> floydWarshall() const;
+            // To disable early stopping(for SSSP problem), call this function without third parameter.
+            void Dijkstra(search_workspace<distance_type>&, unsigned int, unsigned int = 0) const;
+            void DijkstraSearch(search_workspace<double>&, unsigned int, unsigned int, std::false_type) const;
+            void DijkstraSearch(search_workspace<unsigned long long>&, unsigned int, unsigned int, std::true_type) const;
+            template<typename Queue>
+            void DijkstraSearch(search_workspace<unsigned long long>&, unsigned int, unsigned int, Queue &) const;
+            // A* guided by the heuristic(a callable taking a vertex label). Reopens vertices, so an admissible heuristic need not be consistent.
+            template<typename Heuristic>
+            void AStar(search_workspace<double>&, unsigned int, unsigned int, Heuristic &) const;
+            // Fills the (id - bestDistance) array(all infinity but the source) with parallel delta-stepping, given the bucket width and the number of threads.
+            void deltaStepping(std::vector<std::atomic<double>>&, unsigned int, double, unsigned int) const;
+            void bellmanFord(search_workspace<double>&, unsigned int) const;
+            void bellmanFord(search_workspace<double>&, const std::vector<unsigned int>&) const;
+            // Direction-optimizing BFS, given the number of threads(0 -> one per core) for levels of at least _PARALLEL_BFS_THRESHOLD_ vertices.
+            // The second form continues a search whose visited set is shared with earlier ones(does nothing if the source was visited).
+            void breadthFirstSearch(search_workspace<double>&, unsigned int, unsigned int) const;
+            void breadthFirstSearch(search_workspace<double>&, unsigned int, bfs_frontier&, unsigned int) const;
+            // Runs the remaining levels of a BFS, from the level Touched[first, end), with the given number of threads.
+            void parallelBreadthFirstSearch(search_workspace<double>&, std::size_t, bfs_frontier&, unsigned int) const;
+            // Expands the BFS level Touched[first, last) by one level, top-down or bottom-up. With reverse = true the edges are followed backwards.
+            void breadthFirstStep(search_workspace<double>&, std::size_t, std::size_t, bfs_frontier&, bool) const;
+            // Direction-optimizing BFS from the source over out-edges and from the destination over in-edges. Returns the id where the shortest path meets(0 if unreachable).
+            unsigned int bidirectionalSearch(search_workspace<double>&, search_workspace<double>&, unsigned int, unsigned int) const;
+            // Dijkstra from the source over out-edges and from the destination over in-edges at once. Returns the id where the shortest path meets(0 if unreachable).
+            unsigned int bidirectionalDijkstra(search_workspace<distance_type>&, search_workspace<distance_type>&, unsigned int, unsigned int) const;
+            // Blocked Floyd-Warshall over dense matrices(tiles of each phase run by all the cores).
+            void floydWarshall(const std::vector<unsigned int>&, dense_matrix<double>&, dense_matrix<std::uint32_t>&) const;
+            // Same result as floydWarshall, from one Dijkstra per vertex over weights reweighted by Bellman-Ford potentials(run by all the cores).
+            void johnson(const std::vector<unsigned int>&, dense_matrix<double>&, dense_matrix<std::uint32_t>&) const;
+            // Dijkstra over the reduced weights w(u, v) + h(u) - h(v), given the potentials h. Fills the workspace with reduced distances.
+            void reducedDijkstra(search_workspace<double>&, indexed_heap<std::pair<double, unsigned int>>&, std::vector<unsigned int>&, unsigned int, const std::vector<double>&) const;
+            // Multi-source BFS from Sources[first, last), up to 64 * Lanes of them at once. Calls reach(id, parent, level, sources) whenever a vertex
+            // is reached, with the bitset(Lanes words) of the sources that reach it at that level, bit i standing for Sources[first + i].
+            template<std::size_t Lanes, typename Reach>
+            void multiSourceBFS(source_bitsets<Lanes>&, const std::vector<unsigned int>&, std::size_t, std::size_t, Reach) const;
+            // Same result as floydWarshall for unweighted graphs, from multi-source BFS over batches of 256 sources(run by all the cores).
+            void breadthFirstAllPairs(const std::vector<unsigned int>&, dense_matrix<double>&, dense_matrix<std::uint32_t>&) const;
+            // Given the ids of the sources, fills the largest distance, the sum of the distances and the number of the other vertices each one reaches.
+            void distanceSummary(const std::vector<unsigned int>&, std::vector<double>&, std::vector<double>&, std::vector<std::size_t>&, unsigned int) const;
+            // Picks multi-source BFS for unweighted graphs, Johnson for sparse graphs and Floyd-Warshall for dense ones.
+            void allPairsSearch(const std::vector<unsigned int>&, dense_matrix<double>&, dense_matrix<std::uint32_t>&) const;
+            // Read the results a search left in a workspace. Unreached vertices are reported at infinity distance with an empty path.
+            template<typename D>
+            static double distanceTo(const search_workspace<D>&, unsigned int);
+            template<typename D>
+            std::vector<T> pathTo(const search_workspace<D>&, unsigned int, unsigned int) const;
+            template<typename D>
+            std::vector<T> pathThrough(const search_workspace<D>&, const search_workspace<D>&, unsigned int, unsigned int, unsigned int) const;
+            template<typename D>
+            std::unordered_map<T, double> distancesFrom(const search_workspace<D>&) const;
     };
 }
 
@@ -219,5 +454,9 @@ namespace graph
 #include "const_edge_iterator.hpp"
 #include "node_iterator.hpp"
 #include "edge_iterator.hpp"
+#include "contraction_hierarchy.hpp"
+#include "all_pairs_paths.hpp"
+#include "shortest_path_tree.hpp"
+#include "biconnected_components.hpp"
 
 #endif
\ No newline at end of file
@@ -11,54 +11,52 @@ namespace graph
     template<typename T, typename W>
     typename undirected_graph<T, W>::node_iterator undirected_graph<T, W>::begin()
     {
-        return node_iterator(this->_ADJACENCY_LIST_.begin(), &this->_id_to_node_, &this->_node_to_id_);
+        return node_iterator(0, &this->_alive_, &this->_id_to_node_, &this->_node_to_id_);
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::node_iterator undirected_graph<T, W>::end()
     {
-        return node_iterator(this->_ADJACENCY_LIST_.end(), &this->_id_to_node_, &this->_node_to_id_);
+        return node_iterator(this->_alive_.size(), &this->_alive_, &this->_id_to_node_, &this->_node_to_id_);
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_node_iterator undirected_graph<T, W>::begin() const
     {
-        return const_node_iterator(this->_ADJACENCY_LIST_.begin(), &this->_id_to_node_);
+        return const_node_iterator(0, &this->_alive_, &this->_id_to_node_);
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_node_iterator undirected_graph<T, W>::cbegin() const
     {
-        return const_node_iterator(this->_ADJACENCY_LIST_.cbegin(), &this->_id_to_node_);
+        return const_node_iterator(0, &this->_alive_, &this->_id_to_node_);
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_node_iterator undirected_graph<T, W>::end() const
     {
-        return const_node_iterator(this->_ADJACENCY_LIST_.end(), &this->_id_to_node_);
+        return const_node_iterator(this->_alive_.size(), &this->_alive_, &this->_id_to_node_);
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_node_iterator undirected_graph<T, W>::cend() const
     {
-        return const_node_iterator(this->_ADJACENCY_LIST_.cend(), &this->_id_to_node_);
+        return const_node_iterator(this->_alive_.size(), &this->_alive_, &this->_id_to_node_);
     }
     
     template<typename T, typename W>
     typename undirected_graph<T, W>::edge_iterator undirected_graph<T, W>::begin(int)
     {
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator it = this->_ADJACENCY_LIST_.begin();
-        if(this->empty())
-            return edge_iterator(it, it, &this->_id_to_node_);
-
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator first_it = it;    // This has the first non-empty mapping.
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator last_it = it;     // This has the last non-empty mapping.
+        // Adjacency list of the sentinel(id 0) is always empty. Tombstones have empty adjacency lists too, so they are skipped along with isolated vertices.
+        typename std::vector<std::vector<Node<W>>>::iterator it = this->_ADJACENCY_LIST_.begin();
+        typename std::vector<std::vector<Node<W>>>::iterator first_it = it;     // This has the first non-empty mapping.
+        typename std::vector<std::vector<Node<W>>>::iterator last_it = it;      // This has the last non-empty mapping.
         bool flag = false;
 
         // Finding first_it and last_it.    
         while(it != this->_ADJACENCY_LIST_.end())
         {
-            if(!(it->second.empty()))
+            if(!(it->empty()))
             {
                 if(flag == false)
                 {
@@ -72,115 +70,50 @@ namespace graph
             ++it;
         }
 
-        return edge_iterator(first_it, last_it, &this->_id_to_node_, first_it->second.begin());
+        return edge_iterator(first_it, last_it, this->_ADJACENCY_LIST_.begin(), &this->_id_to_node_, &this->_frozen_, this->reverseAdjacencyList(), &this->_NEIGHBOUR_INDEX_, first_it->begin());
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::edge_iterator undirected_graph<T, W>::end(int)
     {
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator it = this->_ADJACENCY_LIST_.begin();
-        if(this->empty())
-            return edge_iterator(it, it, &this->_id_to_node_);
-
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator first_it = it;
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator last_it = it;
-        bool flag = false;
+        typename std::vector<std::vector<Node<W>>>::iterator it = this->_ADJACENCY_LIST_.begin();
+        typename std::vector<std::vector<Node<W>>>::iterator last_it = it;
 
         while(it != this->_ADJACENCY_LIST_.end())
         {
-            if(!(it->second.empty()))
-            {
-                if(flag == false)
-                {
-                    first_it = it;
-                    flag = true;
-                }
-
+            if(!(it->empty()))
                 last_it = it;
-            }
 
             ++it;
         }
 
-        return edge_iterator(last_it, last_it, &this->_id_to_node_, last_it->second.end());
+        return edge_iterator(last_it, last_it, this->_ADJACENCY_LIST_.begin(), &this->_id_to_node_, &this->_frozen_, this->reverseAdjacencyList(), &this->_NEIGHBOUR_INDEX_, last_it->end());
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_edge_iterator undirected_graph<T, W>::begin(int) const
     {
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator it = this->_ADJACENCY_LIST_.begin();
-        if(this->empty())
-            return const_edge_iterator(it, it, &this->_id_to_node_);
-
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator first_it = it;    // This has the first non-empty mapping.
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator last_it = it;     // This has the last non-empty mapping.
-        bool flag = false;
-
-        // Finding first_it and last_it.    
-        while(it != this->_ADJACENCY_LIST_.end())
-        {
-            if(!(it->second.empty()))
-            {
-                if(flag == false)
-                {
-                    first_it = it;
-                    flag = true;
-                }
-
-                last_it = it;
-            }
-
-            ++it;
-        }
-
-        return const_edge_iterator(first_it, last_it, &this->_id_to_node_, first_it->second.begin());
+        return this->cbegin(0);
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_edge_iterator undirected_graph<T, W>::end(int) const
     {
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator it = this->_ADJACENCY_LIST_.begin();
-        if(this->empty())
-            return const_edge_iterator(it, it, &this->_id_to_node_);
-
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator first_it = it;
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator last_it = it;
-        bool flag = false;
-
-        while(it != this->_ADJACENCY_LIST_.end())
-        {
-            if(!(it->second.empty()))
-            {
-                if(flag == false)
-                {
-                    first_it = it;
-                    flag = true;
-                }
-
-                last_it = it;
-            }
-
-            ++it;
-        }
-
-        return const_edge_iterator(last_it, last_it, &this->_id_to_node_, last_it->second.end());
+        return this->cend(0);
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_edge_iterator undirected_graph<T, W>::cbegin(int) const
     {
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator it = this->_ADJACENCY_LIST_.cbegin();
-        if(this->empty())
-            return const_edge_iterator(it, it, &this->_id_to_node_);
-
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator first_it = it;    // This has the first non-empty mapping.
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator last_it = it;     // This has the last non-empty mapping.
+        typename std::vector<std::vector<Node<W>>>::const_iterator it = this->_ADJACENCY_LIST_.cbegin();
+        typename std::vector<std::vector<Node<W>>>::const_iterator first_it = it;    // This has the first non-empty mapping.
+        typename std::vector<std::vector<Node<W>>>::const_iterator last_it = it;     // This has the last non-empty mapping.
         bool flag = false;
 
         // Finding first_it and last_it.    
         while(it != this->_ADJACENCY_LIST_.cend())
         {
-            if(!(it->second.empty()))
+            if(!(it->empty()))
             {
                 if(flag == false)
                 {
@@ -194,37 +127,24 @@ namespace graph
             ++it;
         }
 
-        return const_edge_iterator(first_it, last_it, &this->_id_to_node_, first_it->second.cbegin());
+        return const_edge_iterator(first_it, last_it, this->_ADJACENCY_LIST_.cbegin(), &this->_id_to_node_, first_it->cbegin());
     }
 
     template<typename T, typename W>
     typename undirected_graph<T, W>::const_edge_iterator undirected_graph<T, W>::cend(int) const
     {
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator it = this->_ADJACENCY_LIST_.cbegin();
-        if(this->empty())
-            return const_edge_iterator(it, it, &this->_id_to_node_);
-
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator first_it = it;
-        typename std::unordered_map<unsigned int, std::vector<Node<W>>>::const_iterator last_it = it;
-        bool flag = false;
+        typename std::vector<std::vector<Node<W>>>::const_iterator it = this->_ADJACENCY_LIST_.cbegin();
+        typename std::vector<std::vector<Node<W>>>::const_iterator last_it = it;
 
         while(it != this->_ADJACENCY_LIST_.cend())
         {
-            if(!(it->second.empty()))
-            {
-                if(flag == false)
-                {
-                    first_it = it;
-                    flag = true;
-                }
-
+            if(!(it->empty()))
                 last_it = it;
-            }
 
             ++it;
         }
 
-        return const_edge_iterator(last_it, last_it, &this->_id_to_node_, last_it->second.cend());
+        return const_edge_iterator(last_it, last_it, this->_ADJACENCY_LIST_.cbegin(), &this->_id_to_node_, last_it->cend());
     }
 
     /*
@@ -232,6 +152,9 @@ namespace graph
      */
     template<typename T, typename W>
     undirected_graph<T, W>::undirected_graph() noexcept
+        : _ADJACENCY_LIST_ ( 1 )        // Slot 0 belongs to the sentinel id.
+        , _id_to_node_ ( 1 )
+        , _alive_ ( 1, false )
     {
     }
 
@@ -240,6 +163,7 @@ namespace graph
     {
         this->_ADJACENCY_LIST_.clear();
         this->_id_to_node_.clear();
+        this->_alive_.clear();
         this->_node_to_id_.clear();
     }
 
@@ -247,10 +171,14 @@ namespace graph
     undirected_graph<T, W>::undirected_graph(const undirected_graph &rhs) noexcept
         : _ADJACENCY_LIST_ ( rhs._ADJACENCY_LIST_ )
         , _id_to_node_ ( rhs._id_to_node_ )
+        , _alive_ ( rhs._alive_ )
         , _node_to_id_ (rhs._node_to_id_)
         , isNegWeighted ( rhs.isNegWeighted )
         , isWeighted ( rhs.isWeighted )
         , _id_ ( rhs._id_ )
+        , _CSR_ ( rhs._CSR_ )
+        , _frozen_ ( rhs._frozen_ )
+        , _NEIGHBOUR_INDEX_ ( rhs._NEIGHBOUR_INDEX_ )
     {
     }
 
@@ -259,10 +187,14 @@ namespace graph
     {
         this->_ADJACENCY_LIST_ = rhs._ADJACENCY_LIST_;
         this->_id_to_node_ = rhs._id_to_node_;
+        this->_alive_ = rhs._alive_;
         this->_node_to_id_ = rhs._node_to_id_;
         this->isNegWeighted = rhs.isNegWeighted;
         this->isWeighted = rhs.isWeighted;
         this->_id_ = rhs._id_;
+        this->_CSR_ = rhs._CSR_;
+        this->_frozen_ = rhs._frozen_;
+        this->_NEIGHBOUR_INDEX_ = rhs._NEIGHBOUR_INDEX_;
         return *this;
     }
 
@@ -270,11 +202,17 @@ namespace graph
     undirected_graph<T, W>::undirected_graph(undirected_graph &&rhs) noexcept
         : _ADJACENCY_LIST_ ( std::move(rhs._ADJACENCY_LIST_) )
         , _id_to_node_ ( std::move(rhs._id_to_node_) )
+        , _alive_ ( std::move(rhs._alive_) )
         , _node_to_id_ ( std::move(rhs._node_to_id_) )
         , isNegWeighted (std::move(rhs.isNegWeighted) )
         , isWeighted ( std::move(rhs.isWeighted) )
         , _id_ ( std::move(rhs._id_) )
+        , _CSR_ ( std::move(rhs._CSR_) )
+        , _frozen_ ( std::move(rhs._frozen_) )
+        , _NEIGHBOUR_INDEX_ ( std::move(rhs._NEIGHBOUR_INDEX_) )
     {
+        // The moved-from graph must still have the sentinel slot. Derived classes reset their own members, so the call is non-virtual.
+        rhs.undirected_graph::clear();
     }
 
     template<typename T, typename W>
@@ -282,10 +220,15 @@ namespace graph
     {
         this->_ADJACENCY_LIST_ = std::move(rhs._ADJACENCY_LIST_);
         this->_id_to_node_ = std::move(rhs._id_to_node_);
+        this->_alive_ = std::move(rhs._alive_);
         this->_node_to_id_ = std::move(rhs._node_to_id_);
         this->isNegWeighted = std::move(rhs.isNegWeighted);
         this->isWeighted = std::move(rhs.isWeighted);
         this->_id_ = std::move(rhs._id_);
+        this->_CSR_ = std::move(rhs._CSR_);
+        this->_frozen_ = std::move(rhs._frozen_);
+        this->_NEIGHBOUR_INDEX_ = std::move(rhs._NEIGHBOUR_INDEX_);
+        rhs.undirected_graph::clear();
         return *this;
     }
 
@@ -294,6 +237,7 @@ namespace graph
     {
         return this->_ADJACENCY_LIST_ == rhs._ADJACENCY_LIST_
             && this->_id_to_node_ == rhs._id_to_node_
+            && this->_alive_ == rhs._alive_
             && this->_node_to_id_ == rhs._node_to_id_
             && this->isNegWeighted == rhs.isNegWeighted
             && this->isWeighted == rhs.isWeighted;
@@ -304,6 +248,7 @@ namespace graph
     {
         return this->_ADJACENCY_LIST_ != rhs._ADJACENCY_LIST_
             || this->_id_to_node_ != rhs._id_to_node_
+            || this->_alive_ != rhs._alive_
             || this->_node_to_id_ != rhs._node_to_id_
             || this->isNegWeighted != rhs.isNegWeighted
             || this->isWeighted != rhs.isWeighted;
@@ -314,21 +259,50 @@ namespace graph
     {
         this->_ADJACENCY_LIST_.swap(rhs._ADJACENCY_LIST_);
         this->_id_to_node_.swap(rhs._id_to_node_);
+        this->_alive_.swap(rhs._alive_);
         this->_node_to_id_.swap(rhs._node_to_id_);
         std::swap(this->isNegWeighted, rhs.isNegWeighted);
         std::swap(this->isWeighted, rhs.isWeighted);
         std::swap(this->_id_, rhs._id_);
+        std::swap(this->_CSR_, rhs._CSR_);
+        std::swap(this->_frozen_, rhs._frozen_);
+        this->_NEIGHBOUR_INDEX_.swap(rhs._NEIGHBOUR_INDEX_);
     }
 
     template<typename T, typename W>
     void undirected_graph<T, W>::clear()
     {
-        this->_ADJACENCY_LIST_.clear();
-        this->_id_to_node_.clear();
+        this->_ADJACENCY_LIST_.assign(1, std::vector<Node<W>>());
+        this->_id_to_node_.assign(1, T());
+        this->_alive_.assign(1, false);
         this->_node_to_id_.clear();
         this->isNegWeighted = false;
         this->isWeighted = false;
         this->_id_ = 1;
+        this->_CSR_.clear();
+        this->_frozen_ = false;
+        this->_NEIGHBOUR_INDEX_.clear();
+    }
+
+    template<typename T, typename W>
+    unsigned int undirected_graph<T, W>::insertVertex(const T &vertex)
+    {
+        typename std::unordered_map<T, unsigned int>::const_iterator it = this->_node_to_id_.find(vertex);
+        if(it != this->_node_to_id_.end())
+            return it->second;
+
+        // New vertex gets the next sequential id, which is also its index in the per-vertex vectors.
+        this->_node_to_id_.insert(std::make_pair(vertex, this->_id_));
+        this->_id_to_node_.push_back(vertex);
+        this->_alive_.push_back(true);
+        this->_ADJACENCY_LIST_.push_back(std::vector<Node<W>>());
+        return (this->_id_)++;
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::isVertex(unsigned int id) const
+    {
+        return id < this->_alive_.size() && this->_alive_[id];
     }
 
     template<typename T, typename W>
@@ -336,13 +310,11 @@ namespace graph
     {
         try
         {
-            if(this->_node_to_id_.find(vertex) == this->_node_to_id_.end())
-            {
-                this->_id_to_node_.insert(std::make_pair(this->_id_, vertex));
-                this->_node_to_id_.insert(std::make_pair(vertex, this->_id_));
-                this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>()));
-                (this->_id_)++;
-            }
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
+            this->insertVertex(vertex);
             return true;
         }
         catch(const std::exception& e)
@@ -357,16 +329,12 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const T &vertex : vertices)
-            {
-                if(this->_node_to_id_.find(vertex) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex));
-                    this->_node_to_id_.insert(std::make_pair(vertex, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>()));
-                    (this->_id_)++;
-                }
-            }
+                this->insertVertex(vertex);
             return true;
         }
         catch(const std::exception& e)
@@ -381,39 +349,24 @@ namespace graph
     {
         try
         {
-            // If vertex1 is not previously there, add it to the list of nodes.
-            if(this->_node_to_id_.find(vertex1) == this->_node_to_id_.end())
-            {
-                this->_id_to_node_.insert(std::make_pair(this->_id_, vertex1));
-                this->_node_to_id_.insert(std::make_pair(vertex1, this->_id_));
-                this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                (this->_id_)++;
-            }
-
-            // If vertex2 is not previously there, add it to the list of nodes.
-            if(this->_node_to_id_.find(vertex2) == this->_node_to_id_.end())
-            {
-                this->_id_to_node_.insert(std::make_pair(this->_id_, vertex2));
-                this->_node_to_id_.insert(std::make_pair(vertex2, this->_id_));
-                this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                (this->_id_)++;
-            }
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
 
-            unsigned int id1 = this->_node_to_id_.at(vertex1);
-            unsigned int id2 = this->_node_to_id_.at(vertex2);
+            // If vertex1, vertex2 are not previously there, add them to the list of nodes.
+            unsigned int id1 = this->insertVertex(vertex1);
+            unsigned int id2 = this->insertVertex(vertex2);
 
             if(weight < 0)
                 this->isNegWeighted = true;
             if(weight != 1)
                 this->isWeighted = true;
 
-            std::vector<Node<W>> edge_list = this->_ADJACENCY_LIST_.at(id1);
-            if(std::find(edge_list.begin(), edge_list.end(), Node<W>{id2, weight}) == edge_list.end())
-                this->_ADJACENCY_LIST_.at(id1).push_back(Node<W>{id2, weight});
+            if(!this->hasEdge(id1, Node<W>{id2, weight}))
+                this->appendEdge(id1, Node<W>{id2, weight});
 
-            edge_list = this->_ADJACENCY_LIST_.at(id2);
-            if(std::find(edge_list.begin(), edge_list.end(), Node<W>{id1, weight}) == edge_list.end())
-                this->_ADJACENCY_LIST_.at(id2).push_back(Node<W>{id1, weight});
+            if(!this->hasEdge(id2, Node<W>{id1, weight}))
+                this->appendEdge(id2, Node<W>{id1, weight});
 
             return true;
         }
@@ -429,39 +382,24 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::pair<T, T> &e : edges)
             {
                 T vertex1 = e.first;
                 T vertex2 = e.second;
                 
-                // If vertex1 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex1) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex1));
-                    this->_node_to_id_.insert(std::make_pair(vertex1, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
-                }
-
-                // If vertex2 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex2) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex2));
-                    this->_node_to_id_.insert(std::make_pair(vertex2, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
-                }
-
-                unsigned int id1 = this->_node_to_id_.at(vertex1);
-                unsigned int id2 = this->_node_to_id_.at(vertex2);
+                // If vertex1, vertex2 are not previously there, add them to the list of nodes.
+                unsigned int id1 = this->insertVertex(vertex1);
+                unsigned int id2 = this->insertVertex(vertex2);
 
-                std::vector<Node<W>> edge_list = this->_ADJACENCY_LIST_.at(id1);
-                if(std::find(edge_list.begin(), edge_list.end(), id2) == edge_list.end())
-                    this->_ADJACENCY_LIST_.at(id1).push_back(Node<W>{id2});
+                if(!this->hasEdge(id1, id2))
+                    this->appendEdge(id1, Node<W>{id2});
 
-                edge_list = this->_ADJACENCY_LIST_.at(id2);
-                if(std::find(edge_list.begin(), edge_list.end(), id1) == edge_list.end())
-                    this->_ADJACENCY_LIST_.at(id2).push_back(Node<W>{id1});
+                if(!this->hasEdge(id2, id1))
+                    this->appendEdge(id2, Node<W>{id1});
             }
 
             return true;
@@ -478,45 +416,30 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::tuple<T, T, W> &e : edges)
             {
                 T vertex1 = std::get<0>(e);
                 T vertex2 = std::get<1>(e);
                 W weight = std::get<2>(e);
 
-                // If vertex1 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex1) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex1));
-                    this->_node_to_id_.insert(std::make_pair(vertex1, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
-                }
-
-                // If vertex2 is not previously there, add it to the list of nodes.
-                if(this->_node_to_id_.find(vertex2) == this->_node_to_id_.end())
-                {
-                    this->_id_to_node_.insert(std::make_pair(this->_id_, vertex2));
-                    this->_node_to_id_.insert(std::make_pair(vertex2, this->_id_));
-                    this->_ADJACENCY_LIST_.insert(std::make_pair(this->_id_, std::vector<Node<W>>{}));
-                    (this->_id_)++;
-                }
-
-                unsigned int id1 = this->_node_to_id_.at(vertex1);
-                unsigned int id2 = this->_node_to_id_.at(vertex2);
+                // If vertex1, vertex2 are not previously there, add them to the list of nodes.
+                unsigned int id1 = this->insertVertex(vertex1);
+                unsigned int id2 = this->insertVertex(vertex2);
 
                 if(weight < 0)
                     this->isNegWeighted = true;
                 if(weight != 1)
                     this->isWeighted = true;
 
-                std::vector<Node<W>> edge_list = this->_ADJACENCY_LIST_.at(id1);
-                if(std::find(edge_list.begin(), edge_list.end(), Node<W>{id2, weight}) == edge_list.end())
-                    this->_ADJACENCY_LIST_.at(id1).push_back(Node<W>{id2, weight});
+                if(!this->hasEdge(id1, Node<W>{id2, weight}))
+                    this->appendEdge(id1, Node<W>{id2, weight});
 
-                edge_list = this->_ADJACENCY_LIST_.at(id2);
-                if(std::find(edge_list.begin(), edge_list.end(), Node<W>{id1, weight}) == edge_list.end())
-                    this->_ADJACENCY_LIST_.at(id2).push_back(Node<W>{id1, weight});
+                if(!this->hasEdge(id2, Node<W>{id1, weight}))
+                    this->appendEdge(id2, Node<W>{id1, weight});
             }
 
             return true;
@@ -529,63 +452,250 @@ namespace graph
     }
 
     template<typename T, typename W>
-    bool undirected_graph<T, W>::removeVertex(T vertex)
+    bool undirected_graph<T, W>::loadEdges(const std::vector<std::tuple<T, T, W>> &edges, unsigned int threads)
     {
         try
         {
-            if(this->_node_to_id_.find(vertex) != this->_node_to_id_.end())
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
+            if(threads == 0)
+                threads = defaultThreads();
+
+            // Interning all the vertices first, so that the edges can be sorted by id.
+            std::vector<std::pair<unsigned int, Node<W>>> records = (threads == 1) ? this->internEdges(edges) : this->internEdgesParallel(edges, threads);
+            this->writeEdges(records);
+            return true;
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << e.what() << '\n';
+            return false;
+        }
+    }
+
+    template<typename T, typename W>
+    std::vector<std::pair<unsigned int, Node<W>>> undirected_graph<T, W>::internEdges(const std::vector<std::tuple<T, T, W>> &edges)
+    {
+        std::vector<std::pair<unsigned int, Node<W>>> records;
+        records.reserve(edges.size());
+        for(const std::tuple<T, T, W> &e : edges)
+        {
+            unsigned int id1 = this->insertVertex(std::get<0>(e));
+            unsigned int id2 = this->insertVertex(std::get<1>(e));
+            W weight = std::get<2>(e);
+
+            if(weight < 0)
+                this->isNegWeighted = true;
+            if(weight != 1)
+                this->isWeighted = true;
+
+            records.push_back(std::make_pair(id1, Node<W>{id2, weight}));
+        }
+
+        return records;
+    }
+
+    template<typename T, typename W>
+    std::vector<std::pair<unsigned int, Node<W>>> undirected_graph<T, W>::internEdgesParallel(const std::vector<std::tuple<T, T, W>> &edges, unsigned int threads)
+    {
+        // PHASE-1: Each worker takes a block of edges. Labels already in the graph are resolved through _node_to_id_(which is only read here),
+        // new labels are interned in a concurrent table. Token of an endpoint is either its id or (NEW_LABEL | token in the table).
+        const std::uint64_t NEW_LABEL = std::uint64_t(1) << 63;
+        const std::unordered_map<T, unsigned int> &node_to_id = this->_node_to_id_;
+        label_table<T> Labels;
+        std::vector<std::uint64_t> Tokens(2 * edges.size());
+        std::vector<char> NegWeighted(threads, false);
+        std::vector<char> Weighted(threads, false);
+
+        parallelFor(edges.size(), threads, [&](unsigned int t, std::size_t first, std::size_t last)
+        {
+            for(std::size_t i = first; i < last; ++i)
             {
-                unsigned int id = this->_node_to_id_.at(vertex);
-                
-                // Removing from _id_to_node_.
-                this->_id_to_node_.erase(id);
+                const T *Ends[2] = {&std::get<0>(edges[i]), &std::get<1>(edges[i])};
+                for(std::size_t k = 0; k < 2; ++k)
+                {
+                    typename std::unordered_map<T, unsigned int>::const_iterator it = node_to_id.find(*Ends[k]);
+                    Tokens[2 * i + k] = (it != node_to_id.end()) ? it->second : (NEW_LABEL | Labels.intern(*Ends[k], 2 * i + k));
+                }
+
+                W weight = std::get<2>(edges[i]);
+                if(weight < 0)
+                    NegWeighted[t] = true;
+                if(weight != 1)
+                    Weighted[t] = true;
+            }
+        });
 
-                // Removing from _ADJACENCY_LIST_.
-                this->_ADJACENCY_LIST_.erase(id);
-                for(typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator it = this->_ADJACENCY_LIST_.begin(); it != this->_ADJACENCY_LIST_.end(); it++)
+        // PHASE-2: New labels get sequential ids in the order of their first appearance in the input, just like a serial load would number them.
+        std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> Order;      // (first position, shard, index in the shard)
+        std::vector<std::vector<unsigned int>> NewIds(Labels.shards());
+        for(std::size_t s = 0; s < Labels.shards(); ++s)
+        {
+            NewIds[s].resize(Labels.labels(s).size());
+            for(std::size_t j = 0; j < Labels.labels(s).size(); ++j)
+                Order.push_back(std::make_tuple(Labels.firstSeen(s)[j], s, j));
+        }
+        std::sort(Order.begin(), Order.end());
+
+        this->_node_to_id_.reserve(this->_node_to_id_.size() + Order.size());
+        this->_id_to_node_.reserve(this->_id_to_node_.size() + Order.size());
+        this->_alive_.reserve(this->_alive_.size() + Order.size());
+        this->_ADJACENCY_LIST_.reserve(this->_ADJACENCY_LIST_.size() + Order.size());
+        for(const std::tuple<std::size_t, std::size_t, std::size_t> &label : Order)
+            NewIds[std::get<1>(label)][std::get<2>(label)] = this->insertVertex(Labels.labels(std::get<1>(label))[std::get<2>(label)]);
+
+        // PHASE-3: Each worker translates the tokens of its block into ids and fills its part of the records.
+        std::vector<std::pair<unsigned int, Node<W>>> records(edges.size(), std::make_pair(0u, Node<W>{0}));
+        parallelFor(edges.size(), threads, [&](unsigned int, std::size_t first, std::size_t last)
+        {
+            for(std::size_t i = first; i < last; ++i)
+            {
+                unsigned int Ids[2];
+                for(std::size_t k = 0; k < 2; ++k)
                 {
-                    if(std::find(it->second.begin(), it->second.end(), id) != it->second.end())
-                    {
-                        // Erase-Remove Idiom to remove vertex from the list.
-                        it->second.erase(std::remove(it->second.begin(), it->second.end(), id), it->second.end());
-                    }
+                    std::uint64_t token = Tokens[2 * i + k];
+                    Ids[k] = (token & NEW_LABEL) ? NewIds[(token & ~NEW_LABEL) >> 32][token & 0xFFFFFFFF] : token;
                 }
 
-                // Removing from _node_to_id_.
-                this->_node_to_id_.erase(vertex);
+                records[i] = std::make_pair(Ids[0], Node<W>{Ids[1], std::get<2>(edges[i])});
+            }
+        });
+
+        for(unsigned int t = 0; t < threads; ++t)
+        {
+            if(NegWeighted[t])
+                this->isNegWeighted = true;
+            if(Weighted[t])
+                this->isWeighted = true;
+        }
+
+        return records;
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::writeEdges(std::vector<std::pair<unsigned int, Node<W>>> &records)
+    {
+        // Each edge is present in the adjacency lists of both the vertices.
+        std::size_t count = records.size();
+        records.reserve(2 * count);
+        for(std::size_t i = 0; i < count; ++i)
+            if(records[i].first != records[i].second.vertex)
+                records.push_back(std::make_pair(records[i].second.vertex, Node<W>{records[i].first, records[i].second.weight}));
+
+        this->sortEdges(records);
+        this->appendSortedEdges(records);
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::sortEdges(std::vector<std::pair<unsigned int, Node<W>>> &records) const
+    {
+        // LSD radix sort with 16 bit digits. Target digits are sorted first, so that the final order is by source and then by target.
+        std::vector<std::pair<unsigned int, Node<W>>> buffer(records.size(), std::make_pair(0u, Node<W>{0}));
+        std::vector<std::size_t> Count(1 << 16);
+        unsigned int digits = (this->_id_ - 1 > 0xFFFF) ? 2 : 1;
 
-                // Decrementing the id values for id's greater than the id of removed vertex.
-                // for(std::pair<unsigned int, T> &node : this->_id_to_node_)
-                //     if(node.first > id)
-                //         --node.first;
+        for(unsigned int pass = 0; pass < 2 * digits; ++pass)
+        {
+            bool bySource = pass >= digits;
+            unsigned int shift = 16 * (pass % digits);
+
+            std::fill(Count.begin(), Count.end(), 0);
+            for(const std::pair<unsigned int, Node<W>> &record : records)
+                ++Count[((bySource ? record.first : record.second.vertex) >> shift) & 0xFFFF];
+
+            std::size_t position = 0;
+            for(std::size_t &count : Count)
+            {
+                std::size_t bucketSize = count;
+                count = position;
+                position += bucketSize;
+            }
 
-                // for(std::pair<T, unsigned int> &node : this->_node_to_id_)
-                //     if(node.second > id)
-                //         --node.second;
+            for(const std::pair<unsigned int, Node<W>> &record : records)
+                buffer[Count[((bySource ? record.first : record.second.vertex) >> shift) & 0xFFFF]++] = record;
 
-                bool stillWeighted = false;
-                bool stillNegWeighted = false;
-                for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
+            records.swap(buffer);
+        }
+
+        // Parallel edges(same source and target) are now adjacent; ordering them by weight brings the exact duplicates together.
+        for(std::size_t first = 0; first < records.size(); )
+        {
+            std::size_t last = first + 1;
+            while(last < records.size() && records[last].first == records[first].first && records[last].second.vertex == records[first].second.vertex)
+                ++last;
+
+            if(last - first > 1)
+                std::sort(records.begin() + first, records.begin() + last, [](const std::pair<unsigned int, Node<W>> &a, const std::pair<unsigned int, Node<W>> &b){ return a.second.weight < b.second.weight; });
+
+            first = last;
+        }
+        records.erase(std::unique(records.begin(), records.end()), records.end());
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::appendSortedEdges(std::vector<std::pair<unsigned int, Node<W>>> &records)
+    {
+        std::size_t kept = 0;
+        for(std::size_t first = 0; first < records.size(); )
+        {
+            unsigned int source = records[first].first;
+            std::size_t last = first;
+            while(last < records.size() && records[last].first == source)
+                ++last;
+
+            std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[source];
+            std::size_t oldSize = edge_list.size();
+            edge_list.reserve(oldSize + (last - first));
+
+            typename std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>>::iterator index = this->_NEIGHBOUR_INDEX_.find(source);
+            for(std::size_t i = first; i < last; ++i)
+            {
+                // The records are already unique, so only the edges which existed before the load have to be checked.
+                if(oldSize > 0)
                 {
-                    // if(edges.first > id)
-                    //     --edges.first;
-
-                    for(const Node<W> &node : edges.second)
-                    {
-                        // if(node.vertex > id)
-                        //     --node.vertex;
-
-                        // Finding whether the graph is still weighted/negative weighted.
-                        if(node.weight < 0)
-                            stillNegWeighted = true;
-                        if(node.weight != 1)
-                            stillWeighted = true;
-                    }
+                    if(index != this->_NEIGHBOUR_INDEX_.end() ? this->hasEdge(source, records[i].second)
+                                                              : std::find(edge_list.begin(), edge_list.begin() + oldSize, records[i].second) != edge_list.begin() + oldSize)
+                        continue;
                 }
 
-                // (this->_id_)--;
-                this->isWeighted = stillWeighted;
-                this->isNegWeighted = stillNegWeighted;
+                edge_list.push_back(records[i].second);
+                records[kept++] = records[i];
+            }
+
+            // Indexing the new edges of the high-degree vertices.
+            if(index != this->_NEIGHBOUR_INDEX_.end())
+            {
+                for(std::size_t i = oldSize; i < edge_list.size(); ++i)
+                    index->second.insert(std::make_pair(edge_list[i].vertex, edge_list[i].weight));
+            }
+            else if(edge_list.size() >= _INDEX_THRESHOLD_)
+            {
+                std::unordered_multimap<unsigned int, W> &neighbours = this->_NEIGHBOUR_INDEX_[source];
+                neighbours.reserve(2 * edge_list.size());
+                for(const Node<W> &edge : edge_list)
+                    neighbours.insert(std::make_pair(edge.vertex, edge.weight));
+            }
+
+            first = last;
+        }
+        records.erase(records.begin() + kept, records.end());
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::removeVertex(T vertex)
+    {
+        try
+        {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
+            if(this->_node_to_id_.find(vertex) != this->_node_to_id_.end())
+            {
+                this->eraseVertex(this->_node_to_id_.at(vertex));
+                this->checkGraph();
             }
 
             return true;
@@ -602,64 +712,15 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const T &vertex : vertices)
-            {
                 if(this->_node_to_id_.find(vertex) != this->_node_to_id_.end())
-                {
-                    unsigned int id = this->_node_to_id_.at(vertex);
-
-                    // Removing from _id_to_node_.
-                    this->_id_to_node_.erase(id);
-
-                    // Removing from _ADJACENCY_LIST_.
-                    this->_ADJACENCY_LIST_.erase(id);
-                    for(typename std::unordered_map<unsigned int, std::vector<Node<W>>>::iterator it = this->_ADJACENCY_LIST_.begin(); it != this->_ADJACENCY_LIST_.end(); it++)
-                    {
-                        if(std::find(it->second.begin(), it->second.end(), id) != it->second.end())
-                        {
-                            // Erase-Remove Idiom to remove vertex from the list.
-                            it->second.erase(std::remove(it->second.begin(), it->second.end(), id), it->second.end());
-                        }
-                    }
-
-                    // Removing from _node_to_id_.
-                    this->_node_to_id_.erase(vertex);
-
-                    // Decrementing the id values for id's greater than the id of removed vertex.
-                    // for(std::pair<unsigned int, T> &node : this->_id_to_node_)
-                    //     if(node.first > id)
-                    //         --node.first;
-
-                    // for(std::pair<T, unsigned int> &node : this->_node_to_id_)
-                    //     if(node.second > id)
-                    //         --node.second;
-
-                    bool stillWeighted = false;
-                    bool stillNegWeighted = false;
-                    for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
-                    {
-                        // if(edges.first > id)
-                        //     --edges.first;
-
-                        for(const Node<W> &node : edges.second)
-                        {
-                            // if(node.vertex > id)
-                            //     --node.vertex;
-
-                            // Finding whether the graph is still weighted/negative weighted.
-                            if(node.weight < 0)
-                                stillNegWeighted = true;
-                            if(node.weight != 1)
-                                stillWeighted = true;
-                        }
-                    }
-
-                    // (this->_id_)--;
-                    this->isWeighted = stillWeighted;
-                    this->isNegWeighted = stillNegWeighted;
-                }
-            }
+                    this->eraseVertex(this->_node_to_id_.at(vertex));
 
+            this->checkGraph();
             return true;
         }
         catch(const std::exception& e)
@@ -669,29 +730,134 @@ namespace graph
         }
     }
 
+    template<typename T, typename W>
+    void undirected_graph<T, W>::eraseVertex(unsigned int id)
+    {
+        // Removing the edges which lead to the vertex. Every edge is kept at both of its ends, so only the lists of its neighbours have to be visited.
+        for(const Node<W> &node : this->_ADJACENCY_LIST_[id])
+            if(node.vertex != id)
+                this->eraseEdges(node.vertex, id);
+
+        // Removing from _node_to_id_.
+        this->_node_to_id_.erase(this->_id_to_node_[id]);
+
+        // Leaving a tombstone in the per-vertex vectors. Ids are never reused, so the other ids stay valid.
+        this->_alive_[id] = false;
+        this->_id_to_node_[id] = T();
+        std::vector<Node<W>>().swap(this->_ADJACENCY_LIST_[id]);
+        this->_NEIGHBOUR_INDEX_.erase(id);
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::hasEdge(unsigned int id1, unsigned int id2) const
+    {
+        typename std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>>::const_iterator index = this->_NEIGHBOUR_INDEX_.find(id1);
+        if(index != this->_NEIGHBOUR_INDEX_.end())
+            return index->second.count(id2) > 0;
+
+        const std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id1];
+        return std::find(edge_list.begin(), edge_list.end(), id2) != edge_list.end();
+    }
+
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::hasEdge(unsigned int id1, const Node<W> &node) const
+    {
+        typename std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>>::const_iterator index = this->_NEIGHBOUR_INDEX_.find(id1);
+        if(index != this->_NEIGHBOUR_INDEX_.end())
+        {
+            // Parallel edges to the same target differ only in weight.
+            std::pair<typename std::unordered_multimap<unsigned int, W>::const_iterator, typename std::unordered_multimap<unsigned int, W>::const_iterator> range = index->second.equal_range(node.vertex);
+            for(typename std::unordered_multimap<unsigned int, W>::const_iterator it = range.first; it != range.second; ++it)
+                if(it->second == node.weight)
+                    return true;
+
+            return false;
+        }
+
+        const std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id1];
+        return std::find(edge_list.begin(), edge_list.end(), node) != edge_list.end();
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::appendEdge(unsigned int id1, const Node<W> &node)
+    {
+        std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id1];
+        edge_list.push_back(node);
+
+        typename std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>>::iterator index = this->_NEIGHBOUR_INDEX_.find(id1);
+        if(index != this->_NEIGHBOUR_INDEX_.end())
+            index->second.insert(std::make_pair(node.vertex, node.weight));
+        else if(edge_list.size() >= _INDEX_THRESHOLD_)
+        {
+            // The vertex has just become a high-degree vertex, so index its whole list.
+            std::unordered_multimap<unsigned int, W> &neighbours = this->_NEIGHBOUR_INDEX_[id1];
+            neighbours.reserve(2 * edge_list.size());
+            for(const Node<W> &edge : edge_list)
+                neighbours.insert(std::make_pair(edge.vertex, edge.weight));
+        }
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::eraseEdges(unsigned int id1, unsigned int id2)
+    {
+        // With an index, a missing edge is detected without scanning the list.
+        typename std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>>::iterator index = this->_NEIGHBOUR_INDEX_.find(id1);
+        if(index != this->_NEIGHBOUR_INDEX_.end() && index->second.erase(id2) == 0)
+            return;
+
+        // Erase-Remove Idiom to remove id2 from the list.
+        std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id1];
+        edge_list.erase(std::remove(edge_list.begin(), edge_list.end(), id2), edge_list.end());
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::eraseEdge(unsigned int id1, const Node<W> &node)
+    {
+        typename std::unordered_map<unsigned int, std::unordered_multimap<unsigned int, W>>::iterator index = this->_NEIGHBOUR_INDEX_.find(id1);
+        if(index != this->_NEIGHBOUR_INDEX_.end())
+        {
+            bool found = false;
+            std::pair<typename std::unordered_multimap<unsigned int, W>::iterator, typename std::unordered_multimap<unsigned int, W>::iterator> range = index->second.equal_range(node.vertex);
+            typename std::unordered_multimap<unsigned int, W>::iterator it = range.first;
+            while(it != range.second)
+            {
+                if(it->second == node.weight)
+                {
+                    it = index->second.erase(it);
+                    found = true;
+                }
+                else
+                    ++it;
+            }
+
+            if(!found)
+                return;
+        }
+
+        // Erase-Remove Idiom to remove the edge from the list.
+        std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id1];
+        edge_list.erase(std::remove(edge_list.begin(), edge_list.end(), node), edge_list.end());
+    }
+
     template<typename T, typename W>
     bool undirected_graph<T, W>::removeEdge(T vertex1, T vertex2)
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             if(this->_node_to_id_.find(vertex1) != this->_node_to_id_.end() && this->_node_to_id_.find(vertex2) != this->_node_to_id_.end())
             {
                 unsigned int id1 = this->_node_to_id_.at(vertex1);
                 unsigned int id2 = this->_node_to_id_.at(vertex2);
 
                 // Removing id2 from adjacency list of id1.
-                std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(id1);
-                if(std::find(edge_list1.begin(), edge_list1.end(), id2) != edge_list1.end())
-                {
-                    edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), id2), edge_list1.end());
-                }
+                this->eraseEdges(id1, id2);
 
                 // Removing id1 from adjacency list of id2.
-                std::vector<Node<W>> &edge_list2 = this->_ADJACENCY_LIST_.at(id2);
-                if(std::find(edge_list2.begin(), edge_list2.end(), id1) != edge_list2.end())
-                {
-                    edge_list2.erase(std::remove(edge_list2.begin(), edge_list2.end(), id1), edge_list2.end());
-                }
+                this->eraseEdges(id2, id1);
 
                 this->checkGraph();
             }
@@ -710,6 +876,10 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::pair<T, T> &e : edges)
             {
                 T vertex1 = e.first;
@@ -721,18 +891,10 @@ namespace graph
                     unsigned int id2 = this->_node_to_id_.at(vertex2);
 
                     // Removing id2 from adjacency list of id1.
-                    std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(id1);
-                    if(std::find(edge_list1.begin(), edge_list1.end(), id2) != edge_list1.end())
-                    {
-                        edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), id2), edge_list1.end());
-                    }
+                    this->eraseEdges(id1, id2);
 
                     // Removing id1 from adjacency list of id2.
-                    std::vector<Node<W>> &edge_list2 = this->_ADJACENCY_LIST_.at(id2);
-                    if(std::find(edge_list2.begin(), edge_list2.end(), id1) != edge_list2.end())
-                    {
-                        edge_list2.erase(std::remove(edge_list2.begin(), edge_list2.end(), id1), edge_list2.end());
-                    }
+                    this->eraseEdges(id2, id1);
 
                     this->checkGraph();
                 }
@@ -752,24 +914,20 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             if(this->_node_to_id_.find(vertex1) != this->_node_to_id_.end() && this->_node_to_id_.find(vertex2) != this->_node_to_id_.end())
             {
                 unsigned int id1 = this->_node_to_id_.at(vertex1);
                 unsigned int id2 = this->_node_to_id_.at(vertex2);
 
                 // Removing id2 from adjacency list of id1.
-                std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(id1);
-                if(std::find(edge_list1.begin(), edge_list1.end(), Node<W>{id2, weight}) != edge_list1.end())
-                {
-                    edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), Node<W>{id2, weight}), edge_list1.end());
-                }
+                this->eraseEdge(id1, Node<W>{id2, weight});
 
                 // Removing id1 from adjacency list of id2.
-                std::vector<Node<W>> &edge_list2 = this->_ADJACENCY_LIST_.at(id2);
-                if(std::find(edge_list2.begin(), edge_list2.end(), Node<W>{id1, weight}) != edge_list2.end())
-                {
-                    edge_list2.erase(std::remove(edge_list2.begin(), edge_list2.end(), Node<W>{id1, weight}), edge_list2.end());
-                }
+                this->eraseEdge(id2, Node<W>{id1, weight});
 
                 this->checkGraph();
             }
@@ -788,6 +946,10 @@ namespace graph
     {
         try
         {
+            // A frozen graph cannot be modified.
+            if(this->_frozen_)
+                return false;
+
             for(const std::tuple<T, T, W> &e : edges)
             {
                 T vertex1 = std::get<0>(e);
@@ -800,18 +962,10 @@ namespace graph
                     unsigned int id2 = this->_node_to_id_.at(vertex2);
 
                     // Removing id2 from adjacency list of id1.
-                    std::vector<Node<W>> &edge_list1 = this->_ADJACENCY_LIST_.at(id1);
-                    if(std::find(edge_list1.begin(), edge_list1.end(), Node<W>{id2, weight}) != edge_list1.end())
-                    {
-                        edge_list1.erase(std::remove(edge_list1.begin(), edge_list1.end(), Node<W>{id2, weight}), edge_list1.end());
-                    }
+                    this->eraseEdge(id1, Node<W>{id2, weight});
 
                     // Removing id1 from adjacency list of id2.
-                    std::vector<Node<W>> &edge_list2 = this->_ADJACENCY_LIST_.at(id2);
-                    if(std::find(edge_list2.begin(), edge_list2.end(), Node<W>{id1, weight}) != edge_list2.end())
-                    {
-                        edge_list2.erase(std::remove(edge_list2.begin(), edge_list2.end(), Node<W>{id1, weight}), edge_list2.end());
-                    }
+                    this->eraseEdge(id2, Node<W>{id1, weight});
 
                     this->checkGraph();
                 }
@@ -827,34 +981,71 @@ namespace graph
     }
 
     template<typename T, typename W>
-    void undirected_graph<T, W>::printDFS() const
+    template<typename Discover, typename Visited, typename Finish>
+    bool undirected_graph<T, W>::depthFirstSearch(dfs_stack &Stack, unsigned int root, bool undirected, Discover discover, Visited visited, Finish finish) const
     {
-        std::cout << "DEPTH FIRST SEARCH\n";
+        Stack.Visited[root] = true;
+        Stack.Frames.push_back(dfs_stack::frame{root, 0, 0, false});
+        discover(root, 0);
 
-        std::unordered_set<unsigned int> Visited;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
+        while(!Stack.Frames.empty())
         {
-            if(Visited.find(edges.first) == Visited.end())
+            // The frame is only used before the push below, which may move it.
+            dfs_stack::frame &Top = Stack.Frames.back();
+            edge_range<W> Edges = this->adjacent(Top.vertex);
+
+            // All the edges are done: return to the parent.
+            if(Top.edge == Edges.size())
             {
-                printDFSUtil(edges.first, Visited);
-                std::cout << '\n';
+                unsigned int vertex = Top.vertex;
+                unsigned int parent = Top.parent;
+                Stack.Frames.pop_back();
+                finish(vertex, parent);
+                continue;
+            }
+
+            unsigned int current = Top.vertex;
+            unsigned int next = Edges[Top.edge++].vertex;
+            if(undirected && next == Top.parent && !Top.parentSkipped)
+            {
+                Top.parentSkipped = true;
+                continue;
+            }
+
+            if(!Stack.Visited[next])
+            {
+                Stack.Visited[next] = true;
+                Stack.Frames.push_back(dfs_stack::frame{next, current, 0, false});
+                discover(next, current);
+            }
+            else if(visited(current, next))
+            {
+                Stack.Frames.clear();
+                return true;
             }
         }
+
+        return false;
     }
 
     template<typename T, typename W>
-    void undirected_graph<T, W>::printDFSUtil(unsigned int start, std::unordered_set<unsigned int> &Visited) const
+    void undirected_graph<T, W>::printDFS() const
     {
-        Visited.insert(start);
-        std::cout << this->_id_to_node_.at(start);
-        
-        std::vector<Node<W>> edge_list = this->_ADJACENCY_LIST_.at(start);
-        for(Node<W> N : edge_list)
+        std::cout << "DEPTH FIRST SEARCH\n";
+
+        dfs_stack Stack(this->_id_);
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            if(Visited.find(N.vertex) == Visited.end())
+            if(this->isVertex(id) && !Stack.Visited[id])
             {
-                std::cout << " -> ";
-                printDFSUtil(N.vertex, Visited);
+                depthFirstSearch(Stack, id, false, [this](unsigned int vertex, unsigned int parent)
+                {
+                    if(parent != 0)
+                        std::cout << " -> ";
+                    std::cout << this->_id_to_node_[vertex];
+                },
+                [](unsigned int, unsigned int) { return false; }, [](unsigned int, unsigned int) {});
+                std::cout << '\n';
             }
         }
     }
@@ -864,45 +1055,28 @@ namespace graph
     {
         std::cout << "BREADTH FIRST SEARCH" << '\n';
 
-        std::unordered_set<unsigned int> Visited;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
+        search_workspace<double> &Workspace = threadWorkspace<double>();
+        bfs_frontier Frontier;
+        Workspace.prepare(this->_id_);
+        Frontier.reset(this->_id_);
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            if(Visited.find(edges.first) == Visited.end())
-            {
-                Visited.insert(edges.first);
-                printBFSUtil(edges.first, Visited);
-            }
+            if(this->isVertex(id) && !Frontier.Visited.test(id))
+                printBFSUtil(id, Workspace, Frontier);
         }
     }
 
     template<typename T, typename W>
-    void undirected_graph<T, W>::printBFSUtil(unsigned int start, std::unordered_set<unsigned int> &Visited) const
+    void undirected_graph<T, W>::printBFSUtil(unsigned int start, search_workspace<double> &Workspace, bfs_frontier &Frontier) const
     {
-        std::queue<unsigned int> Q;
-        std::vector<unsigned int> path;
-        unsigned int temp = start;
-        Q.push(temp);
-        Visited.insert(temp);
-
-        while(!Q.empty())
-        {
-            temp = Q.front();
-            Q.pop();
-            path.push_back(temp);
-
-            for(Node<W> N : this->_ADJACENCY_LIST_.at(temp))
-            {
-                if(Visited.find(N.vertex) == Visited.end())
-                {
-                    Visited.insert(N.vertex);
-                    Q.push(N.vertex);
-                }
-            }
-        }
+        // The search appends the component to Touched, level by level.
+        std::size_t first = Workspace.Touched.size();
+        breadthFirstSearch(Workspace, start, Frontier, 1);
+        std::vector<unsigned int> path(Workspace.Touched.begin() + first, Workspace.Touched.end());
 
         for(typename std::vector<unsigned int>::iterator it = path.begin(); it < path.end(); it++)
         {
-            std::cout << this->_id_to_node_.at(*it);
+            std::cout << this->_id_to_node_[*it];
 
             if(it != path.end() - 1)
                 std::cout << " -> ";
@@ -915,47 +1089,40 @@ namespace graph
     {
         unsigned int id = 0;
         std::vector<std::pair<T, T>> Bridges;
-        std::unordered_set<unsigned int> Visited;
-        std::unordered_map<unsigned int, unsigned int> Ids;
-        std::unordered_map<unsigned int, unsigned int> Low;
-
-        for(const std::pair<unsigned int, T> &vertex : this->_id_to_node_)
-            if(Visited.find(vertex.first) == Visited.end())
-                cutEdgesUtil(vertex.first, 0, id, Bridges, Visited, Ids, Low);
-        
-        return Bridges;
-    }
+        std::vector<unsigned int> Ids(this->_id_, 0);
+        std::vector<unsigned int> Low(this->_id_, 0);
+        dfs_stack Stack(this->_id_);
 
-    template<typename T, typename W>
-    void undirected_graph<T, W>::cutEdgesUtil(unsigned int current, unsigned int parent, unsigned int &id, std::vector<std::pair<T, T>> &Bridges, std::unordered_set<unsigned int> &Visited, std::unordered_map<unsigned int, unsigned int> &Ids, std::unordered_map<unsigned int, unsigned int> &Low) const
-    {
-        Visited.insert(current);
-        Ids[current] = Low[current] = id++;
-
-        for(const Node<W> &node : this->_ADJACENCY_LIST_.at(current))
+        for(unsigned int vertex = 1; vertex < this->_id_; ++vertex)
         {
-            unsigned int child = node.vertex;
+            if(!this->isVertex(vertex) || Stack.Visited[vertex])
+                continue;
 
-            // The edge leads back to parent in DFS tree(in undirected graph).
-            if(child == parent) continue;
-            
-            // Visited[child] = false - The edge is part of DFS tree.
-            if(Visited.find(child) == Visited.end())
+            depthFirstSearch(Stack, vertex, true, [&](unsigned int current, unsigned int)
             {
-                cutEdgesUtil(child, current, id, Bridges, Visited, Ids, Low);
-                
-                // Relaxation while recursive callback(propagating the low-link values). 
+                Ids[current] = Low[current] = id++;
+            },
+            [&](unsigned int current, unsigned int child)
+            {
+                // The edge is back edge to one of the ancestors. Updating the low-link values using back-edges.
+                Low[current] = std::min(Low[current], Ids[child]);
+                return false;
+            },
+            [&](unsigned int child, unsigned int current)
+            {
+                if(current == 0)
+                    return;
+
+                // Propagating the low-link values to the parent.
                 Low[current] = std::min(Low[current], Low[child]);
-                
+
                 // Finding the bridges - There is no back-edge from 'child' to any of the ancestors, including to 'current'.
                 if(Low[child] > Ids[current])
-                    Bridges.push_back(std::pair<T, T>(this->_id_to_node_.at(current), this->_id_to_node_.at(child)));
-            }
-            // Visited[child] = true && child ≠ parent - The edge is back edge to one of the ancestors.
-            else
-                // Updating the low-link values using back-edges.
-                Low[current] = std::min(Low[current], Ids[child]);
+                    Bridges.push_back(std::pair<T, T>(this->_id_to_node_[current], this->_id_to_node_[child]));
+            });
         }
+
+        return Bridges;
     }
 
     template<typename T, typename W>
@@ -963,92 +1130,75 @@ namespace graph
     {
         unsigned int id = 0;
         std::vector<T> ArtPoints;
-        std::unordered_set<unsigned int> Visited;
-        std::unordered_map<unsigned int, unsigned int> Ids;
-        std::unordered_map<unsigned int, unsigned int> Low;
-
-        for(const std::pair<unsigned int, T> &vertex : this->_id_to_node_)
-            if(Visited.find(vertex.first) == Visited.end())
-                cutVerticesUtil(id, ArtPoints, Visited, Ids, Low, vertex.first, 0);
-        
-        return ArtPoints;
-    }
-
-    template<typename T, typename W>
-    void undirected_graph<T, W>::cutVerticesUtil(unsigned int &id, std::vector<T> &ArtPoints, std::unordered_set<unsigned int> &Visited, std::unordered_map<unsigned int, unsigned int> &Ids, std::unordered_map<unsigned int, unsigned int> &Low, unsigned int current, unsigned int parent) const
-    {
-        Visited.insert(current);
-        Ids[current] = Low[current] = id++;
-
-        int rootNodeOutgoingEdgeCount = 0;
-
-        for(const Node<W> &node : this->_ADJACENCY_LIST_.at(current))
+        std::vector<unsigned int> Ids(this->_id_, 0);
+        std::vector<unsigned int> Low(this->_id_, 0);
+        std::vector<unsigned int> Parent(this->_id_, 0);
+        std::vector<unsigned int> Children(this->_id_, 0);     // Number of children in the DFS tree.
+        std::vector<bool> isCut(this->_id_, false);
+        dfs_stack Stack(this->_id_);
+
+        for(unsigned int vertex = 1; vertex < this->_id_; ++vertex)
         {
-            unsigned int child = node.vertex;
-
-            // The edge leads back to parent in DFS tree(in undirected graph).
-            if(current == parent) continue;
+            if(!this->isVertex(vertex) || Stack.Visited[vertex])
+                continue;
 
-            // Visited[child] = false - The edge is part of DFS tree.
-            if(Visited.find(child) == Visited.end())
+            depthFirstSearch(Stack, vertex, true, [&](unsigned int current, unsigned int parent)
+            {
+                Ids[current] = Low[current] = id++;
+                Parent[current] = parent;
+            },
+            [&](unsigned int current, unsigned int child)
             {
-                cutVerticesUtil(id, ArtPoints, Visited, Ids, Low, child, current);
+                // The edge is back-edge to one of the ancestors. Updating the low-link values using back-edges.
+                Low[current] = std::min(Low[current], Ids[child]);
+                return false;
+            },
+            [&](unsigned int child, unsigned int current)
+            {
+                if(current == 0)
+                    return;
 
-                // Relaxation while recursive callback(propagating the low-link values). 
+                // Propagating the low-link values to the parent.
                 Low[current] = std::min(Low[current], Low[child]);
+                ++Children[current];
 
                 // Finding the articulation points - There is no back-edge from 'child' to any of the ancestors(back-edge to 'current' is allowed).
-                if(Low[child] >= Ids[current] && parent != 0)
-                    ArtPoints.push_back(this->_id_to_node_.at(current));
-                
-                rootNodeOutgoingEdgeCount++;
-            }
-            // Visited[child] = true && child ≠ parent - The edge is back-edge to one of the ancestors.
-            else
-                // Updating the low-link values using back-edges.
-                Low[current] = std::min(Low[current], Ids[child]);
-            
+                if(Low[child] >= Ids[current] && Parent[current] != 0 && !isCut[current])
+                {
+                    isCut[current] = true;
+                    ArtPoints.push_back(this->_id_to_node_[current]);
+                }
+            });
+
+            // The root is an articulation point if it has more than one child in the DFS tree.
+            if(Children[vertex] > 1)
+                ArtPoints.push_back(this->_id_to_node_[vertex]);
         }
 
-        // If the parent node in this call is the root node && and has more than one outgoing edges - it is an articulation point.
-        if(parent == 0 && rootNodeOutgoingEdgeCount > 1)
-            ArtPoints.push_back(this->_id_to_node_.at(current));
+        return ArtPoints;
     }
 
     template<typename T, typename W>
-    std::vector<std::vector<T>> undirected_graph<T, W>::connectedComponents() const
+    std::vector<std::vector<T>> undirected_graph<T, W>::connectedComponents(unsigned int threads) const
     {
-        std::queue<unsigned int> Q;
-        std::unordered_set<unsigned int> Visited;
+        search_workspace<double> &Workspace = threadWorkspace<double>();
+        bfs_frontier Frontier;
         std::vector<std::vector<T>> ConnectedComponents;
+        Workspace.prepare(this->_id_);
+        Frontier.reset(this->_id_);
 
-        // For each connected component.
-        for(const std::pair<unsigned int, T> &vertex : this->_id_to_node_)
+        // For each connected component, find all its vertices with one BFS. The searches share the visited set.
+        for(unsigned int vertex = 1; vertex < this->_id_; ++vertex)
         {
-            if(Visited.find(vertex.first) == Visited.end())
+            if(this->isVertex(vertex) && !Frontier.Visited.test(vertex))
             {
-                std::vector<T> Component;
-                Component.push_back(this->_id_to_node_.at(vertex.first));
-                Visited.insert(vertex.first);
-                Q.push(vertex.first);
-                
-                // Find all vertices in the component.
-                while(!Q.empty())
-                {
-                    unsigned int top = Q.front();
-                    Q.pop();
-
-                    for(const Node<W> &node : this->_ADJACENCY_LIST_.at(top))
-                    {
-                        if(Visited.find(node.vertex) == Visited.end())
-                        {
-                            Component.push_back(this->_id_to_node_.at(node.vertex));
-                            Visited.insert(node.vertex);
-                            Q.push(node.vertex);
-                        }
-                    }
-                }
+                std::size_t first = Workspace.Touched.size();
+                breadthFirstSearch(Workspace, vertex, Frontier, threads);
 
+                std::vector<T> Component;
+                Component.reserve(Workspace.Touched.size() - first);
+                for(std::size_t i = first; i < Workspace.Touched.size(); ++i)
+                    Component.push_back(this->_id_to_node_[Workspace.Touched[i]]);
                 ConnectedComponents.push_back(Component);
             }
         }
@@ -1070,21 +1220,23 @@ namespace graph
     std::vector<std::tuple<T, T, W>> undirected_graph<T, W>::minimumSpanningTree() const
     {
         // Empty spanning tree for empty graph.
-        if(this->_ADJACENCY_LIST_.size() == 0)
+        if(this->empty())
             return std::vector<std::tuple<T, T, W>>();
 
         typedef std::tuple<unsigned int, unsigned int, W> tuple;
 
         std::priority_queue<tuple, std::vector<tuple>, minTupleComp<W>> Q;
-        int maxEdges = this->_id_to_node_.size() - 1;
+        int maxEdges = this->_node_to_id_.size() - 1;
         std::unordered_set<unsigned int> mstVertices;                       // Set of vertices which are added in the MST.
         std::vector<std::tuple<T, T, W>> mstEdges;                          // Vector of edges added in the MST.
         int edgeCount = 0;                                                  // Tracks the number of edges included in the MST.
         
         // Initialization phase. Add 's' to the MST vertex set and add all its edges into the priority queue.
-        unsigned int s = (this->_id_to_node_.begin())->first;
+        unsigned int s = 1;
+        while(!this->isVertex(s))
+            ++s;
         mstVertices.insert(s);
-        for(const Node<W> &node : this->_ADJACENCY_LIST_.at(s))
+        for(const Node<W> &node : this->adjacent(s))
             if(node.vertex != s)                                            // Simplified check for vertices not in mstVertices set.
                 Q.push(tuple(s, node.vertex, node.weight));
 
@@ -1100,12 +1252,12 @@ namespace graph
                 continue;
 
             // Add the edge to the MST.
-            mstEdges.push_back( std::tuple<T, T, W>( this->_id_to_node_.at(std::get<0>(edge)), this->_id_to_node_.at(std::get<1>(edge)), std::get<2>(edge) ) );
+            mstEdges.push_back( std::tuple<T, T, W>( this->_id_to_node_[std::get<0>(edge)], this->_id_to_node_[std::get<1>(edge)], std::get<2>(edge) ) );
             edgeCount++;
 
             // Add the current vertex to MST & push all the edges of current vertex into priority queue. 
             mstVertices.insert(s);
-            for(const Node<W> &node : this->_ADJACENCY_LIST_.at(s))
+            for(const Node<W> &node : this->adjacent(s))
                 if(mstVertices.find(node.vertex) == mstVertices.end())
                     Q.push(tuple(s, node.vertex, node.weight));
         }
@@ -1120,28 +1272,15 @@ namespace graph
     template<typename T, typename W>
     bool undirected_graph<T, W>::isCyclic() const
     {
-        std::unordered_set<unsigned int> Visited;
-
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
-            if(Visited.find(edges.first) == Visited.end())
-                if(isCyclicUtil(edges.first, Visited, 0))
-                    return true;
-
-        return false;
-    }
-
-    template<typename T, typename W>
-    bool undirected_graph<T, W>::isCyclicUtil(unsigned int current, std::unordered_set<unsigned int> &Visited, unsigned int parent) const
-    {
-        Visited.insert(current);
+        dfs_stack Stack(this->_id_);
 
-        for(const Node<W> &child : this->_ADJACENCY_LIST_.at(current))
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            if(Visited.find(child.vertex) == Visited.end())
-                if(isCyclicUtil(child.vertex, Visited, current))
-                    return true;
-            // Visited[child] = true && child != parent -- There is a back-edge between 'child' and 'current'
-            else if(child.vertex != parent)
+            if(!this->isVertex(id) || Stack.Visited[id])
+                continue;
+
+            // Visited[child] = true && the edge is not the tree edge to the parent -- There is a back-edge between 'child' and 'current'.
+            if(depthFirstSearch(Stack, id, true, [](unsigned int, unsigned int) {}, [](unsigned int, unsigned int) { return true; }, [](unsigned int, unsigned int) {}))
                 return true;
         }
 
@@ -1152,13 +1291,17 @@ namespace graph
     void undirected_graph<T, W>::printGraph() const
     {
         std::cout << "ADJACENCY LIST" << '\n';
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &e : this->_ADJACENCY_LIST_)
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            std::cout << this->_id_to_node_.at(e.first) << " ->  ";
-            for(typename std::vector<Node<W>>::const_iterator it = e.second.begin(); it < e.second.end(); it++)
+            if(!this->isVertex(id))
+                continue;
+
+            const std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id];
+            std::cout << this->_id_to_node_[id] << " ->  ";
+            for(typename std::vector<Node<W>>::const_iterator it = edge_list.begin(); it < edge_list.end(); it++)
             {
-                std::cout << this->_id_to_node_.at(it->vertex);
-                if(it != e.second.end() - 1)
+                std::cout << this->_id_to_node_[it->vertex];
+                if(it != edge_list.end() - 1)
                     std::cout << ", ";
             }
             std::cout << '\n';
@@ -1169,13 +1312,17 @@ namespace graph
     void undirected_graph<T, W>::printWeightedGraph() const
     {
         std::cout << "ADJACENCY LIST" << '\n';
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &e : this->_ADJACENCY_LIST_)
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            std::cout << this->_id_to_node_.at(e.first) << " ->  ";
-            for(typename std::vector<Node<W>>::const_iterator it = e.second.begin(); it < e.second.end(); it++)
+            if(!this->isVertex(id))
+                continue;
+
+            const std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id];
+            std::cout << this->_id_to_node_[id] << " ->  ";
+            for(typename std::vector<Node<W>>::const_iterator it = edge_list.begin(); it < edge_list.end(); it++)
             {
-                std::cout << '(' << this->_id_to_node_.at(it->vertex) << ", " << it->weight << ')';
-                if(it != e.second.end() - 1)
+                std::cout << '(' << this->_id_to_node_[it->vertex] << ", " << it->weight << ')';
+                if(it != edge_list.end() - 1)
                     std::cout << ", ";
             }
             std::cout << '\n';
@@ -1186,7 +1333,7 @@ namespace graph
     int undirected_graph<T, W>::degree(T vertex) const
     {
         if(this->_node_to_id_.find(vertex) != this->_node_to_id_.end())
-            return this->_ADJACENCY_LIST_.at(this->_node_to_id_.at(vertex)).size();
+            return this->_ADJACENCY_LIST_[this->_node_to_id_.at(vertex)].size();
         else
             return -1;
     }
@@ -1194,28 +1341,72 @@ namespace graph
     template<typename T, typename W>
     bool undirected_graph<T, W>::empty() const
     {
-        return this->_id_to_node_.empty();
+        return this->_node_to_id_.empty();
     }
     
     template<typename T, typename W>
     void undirected_graph<T, W>::printMap() const
     {
         std::cout << "VERTEX MAP" << '\n';
-        for(const std::pair<unsigned int, T> &e : this->_id_to_node_)
+        for(unsigned int id = 1; id < this->_id_; ++id)
         {
-            std::cout << e.first << ' ' << e.second << std::endl;
+            if(this->isVertex(id))
+                std::cout << id << ' ' << this->_id_to_node_[id] << std::endl;
         }
     }
 
+    template<typename T, typename W>
+    bool undirected_graph<T, W>::isFrozen() const
+    {
+        return this->_frozen_;
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::freeze()
+    {
+        this->_CSR_.build(this->_ADJACENCY_LIST_);
+        this->_frozen_ = true;
+    }
+
+    template<typename T, typename W>
+    void undirected_graph<T, W>::thaw()
+    {
+        this->_CSR_.clear();
+        this->_frozen_ = false;
+    }
+
+    template<typename T, typename W>
+    std::vector<std::vector<Node<W>>>* undirected_graph<T, W>::reverseAdjacencyList()
+    {
+        // Every edge of an undirected graph is its own reverse.
+        return nullptr;
+    }
+
+    template<typename T, typename W>
+    edge_range<W> undirected_graph<T, W>::adjacent(unsigned int id) const
+    {
+        if(this->_frozen_)
+            return this->_CSR_.neighbours(id);
+
+        const std::vector<Node<W>> &edge_list = this->_ADJACENCY_LIST_[id];
+        return edge_range<W>(edge_list.data(), edge_list.data() + edge_list.size());
+    }
+
+    template<typename T, typename W>
+    edge_range<W> undirected_graph<T, W>::inAdjacent(unsigned int id) const
+    {
+        return adjacent(id);
+    }
+
     template<typename T, typename W>
     void undirected_graph<T, W>::checkGraph()
     {
         // Finding whether the graph is still weighted/negative Weighted.
         bool stillWeighted = false;
         bool stillNegWeighted = false;
-        for(const std::pair<unsigned int, std::vector<Node<W>>> &edges : this->_ADJACENCY_LIST_)
+        for(const std::vector<Node<W>> &edge_list : this->_ADJACENCY_LIST_)
         {
-            for(const Node<W> &node : edges.second)
+            for(const Node<W> &node : edge_list)
             {
                 if(node.weight < 0)
                     stillNegWeighted = true;